@@ -0,0 +1,65 @@
+# Compiles the path.jerryio exports in static/ into packed binary paths (see include/path/format.hpp)
+# with a host side tool, so the brain never parses path text. Only the compiled blobs are linked,
+# declare them with PATH_ASSET(name) instead of ASSET(name_txt).
+# Compiled assets are linked by tools/assetlink, which stores identical assets once.
+HOSTCXX?=g++
+HOSTCXXFLAGS?=-std=c++17 -O2
+
+# points are kept as exported unless a path opts in to resampling by curvature (see include/path/resample.hpp) with
+# its own tolerance, e.g. PATH_TOLERANCE_Skill1=0.25. Check `make bench` still passes first: bench_resample fails if a
+# resampled path is followed worse than its original points. Resampled points no longer match the .txt rows, which
+# moves Marker::atIndex() markers
+PATH_TOLERANCE?=0
+PATH_SPEED_TOLERANCE?=2
+# under the smallest pure pursuit lookahead in use (4", see LookaheadPolicy), or the follower can cut across a long
+# segment and lose the path
+PATH_MAX_SPACING?=3
+# points are delta encoded, see FLAG_COMPRESSED in include/path/format.hpp. PATH_COMPRESS=0 stores raw floats
+PATH_COMPRESS?=1
+
+PATH_SOURCES=$(wildcard static/*.txt)
+PATH_BINS=$(patsubst static/%.txt,$(BINDIR)/paths/%.path,$(PATH_SOURCES))
+
+# everything in src/path builds for both the brain and the host
+HOST_PATH_SRC=$(wildcard $(SRCDIR)/path/*.cpp)
+
+PATHC=$(BINDIR)/tools/pathc
+PATHC_SRC=tools/pathc.cpp $(HOST_PATH_SRC)
+ASSETLINK=$(BINDIR)/tools/assetlink
+
+# every compiled asset, trajectory-asset.mk adds its own
+LINKED_ASSETS+=$(PATH_BINS)
+LINKED_OBJ=$(BINDIR)/paths/assets.s.o
+
+# text paths are replaced by their compiled form
+ASSET_FILES:=$(filter-out $(PATH_SOURCES),$(ASSET_FILES))
+
+GETALLOBJ=$(sort $(call ASMOBJ,$1) $(call COBJ,$1) $(call CXXOBJ,$1)) $(ASSET_OBJ) $(LINKED_OBJ)
+
+.PRECIOUS: $(BINDIR)/paths/%.path
+
+$(PATHC): $(PATHC_SRC) $(wildcard $(INCDIR)/path/*.hpp) tools/host.hpp
+	$(VV)mkdir -p $(dir $@)
+	@echo "HOSTCXX $@"
+	$(VV)$(HOSTCXX) $(HOSTCXXFLAGS) -I$(INCDIR) $(PATHC_SRC) -o $@
+
+$(ASSETLINK): tools/assetlink.cpp tools/host.hpp
+	$(VV)mkdir -p $(dir $@)
+	@echo "HOSTCXX $@"
+	$(VV)$(HOSTCXX) $(HOSTCXXFLAGS) tools/assetlink.cpp -o $@
+
+$(BINDIR)/paths/%.path: static/%.txt $(PATHC)
+	$(VV)mkdir -p $(dir $@)
+	@echo "PATH $@"
+	$(VV)$(PATHC) --tolerance $(or $(PATH_TOLERANCE_$*),$(PATH_TOLERANCE)) --speed-tolerance $(PATH_SPEED_TOLERANCE) \
+		--max-spacing $(PATH_MAX_SPACING) $(if $(filter 0,$(PATH_COMPRESS)),--raw) $< $@
+
+# second expansion so the assets added by later makefiles are prerequisites too
+$(BINDIR)/paths/assets.s: $$(LINKED_ASSETS) $(ASSETLINK)
+	$(VV)mkdir -p $(dir $@)
+	@echo "ASSETLINK $@"
+	$(VV)$(ASSETLINK) $@ $(LINKED_ASSETS)
+
+$(LINKED_OBJ): $(BINDIR)/paths/assets.s
+	@echo "AS $@"
+	$(VV)$(AS) -c $(ASMFLAGS) -o $@ $<
@@ -0,0 +1,19 @@
+# Host side benchmarks for the path code, run with `make bench`.
+# Every tools/bench/<name>.cpp is built into bin/tools/bench_<name> and run over the compiled paths and trajectories
+# and the path text in static/ and PlanRoutes/. Each bench picks out the files it reads by extension.
+BENCH_SRC=$(wildcard tools/bench/*.cpp)
+BENCH_BINS=$(patsubst tools/bench/%.cpp,$(BINDIR)/tools/bench_%,$(BENCH_SRC))
+BENCH_INPUTS=$(PATH_BINS) $(TRAJ_ALL_BINS) $(PATH_SOURCES) $(wildcard PlanRoutes/*.txt)
+# the motion code that builds on the host without PROS
+BENCH_MOTION_SRC=$(SRCDIR)/motion/settle.cpp $(SRCDIR)/motion/timeout.cpp
+BENCH_DEPS=$(HOST_PATH_SRC) $(BENCH_MOTION_SRC) $(wildcard $(INCDIR)/path/*.hpp) $(INCDIR)/motion/feedforward.hpp \
+           $(INCDIR)/motion/settle.hpp $(INCDIR)/motion/timeout.hpp tools/host.hpp $(wildcard tools/bench/*.hpp)
+
+.PHONY: bench
+bench: $(BENCH_BINS) $(PATH_BINS) $$(TRAJ_ALL_BINS)
+	$(VV)for bench in $(BENCH_BINS); do echo "== $$bench"; $$bench $(BENCH_INPUTS) || exit 1; done
+
+$(BINDIR)/tools/bench_%: tools/bench/%.cpp $(BENCH_DEPS)
+	$(VV)mkdir -p $(dir $@)
+	@echo "HOSTCXX $@"
+	$(VV)$(HOSTCXX) $(HOSTCXXFLAGS) -I$(INCDIR) $< $(HOST_PATH_SRC) $(BENCH_MOTION_SRC) -o $@
@@ -0,0 +1,13 @@
+# Host side fit of drivetrain characterization logs, see include/motion/sysid.hpp and tools/sysid.cpp.
+# `make sysid` builds bin/tools/sysid and checks the fit against a simulated drivetrain with known gains.
+SYSID=$(BINDIR)/tools/sysid
+SYSID_SRC=tools/sysid.cpp $(SRCDIR)/motion/sysid.cpp
+
+.PHONY: sysid
+sysid: $(SYSID)
+	$(VV)$(SYSID) --synthetic
+
+$(SYSID): $(SYSID_SRC) $(INCDIR)/motion/sysid.hpp $(INCDIR)/motion/feedforward.hpp tools/host.hpp
+	$(VV)mkdir -p $(dir $@)
+	@echo "HOSTCXX $@"
+	$(VV)$(HOSTCXX) $(HOSTCXXFLAGS) -I$(INCDIR) $(SYSID_SRC) -o $@
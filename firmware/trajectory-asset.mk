@@ -0,0 +1,35 @@
+# Generates time parameterized trajectories (see include/path/trajectory.hpp) from the Bezier controls stored in the
+# trailer of the paths in static/. Only the paths named in TRAJ_PATHS get one linked into the firmware, declare them
+# with TRAJECTORY_ASSET(name). A trajectory holds a sample every TRAJ_DT, so they are far bigger than the paths.
+# The drivetrain limits have to match the Drivetrain in src/config.cpp. The acceleration limit is a placeholder, so
+# no routine follows a trajectory yet. Set it from the kA the CHARACTERIZE autonomous prints: with kS and kV from the
+# same fit, the robot accelerates at (127 - kS - kV * speed) / kA, so use that at the path's top speed with some margin.
+TRAJ_RPM?=450
+TRAJ_WHEEL?=3.25
+TRAJ_TRACK?=11.4
+TRAJ_ACCEL?=100
+TRAJ_DT?=0.01
+
+# names of the paths in static/ to link trajectories for, e.g. TRAJ_PATHS=RedRing1 Skill1
+TRAJ_PATHS?=
+
+TRAJ_BINS=$(patsubst %,$(BINDIR)/paths/%.traj,$(TRAJ_PATHS))
+# a trajectory for every path, only built for the host benches
+TRAJ_ALL_BINS=$(patsubst static/%.txt,$(BINDIR)/paths/%.traj,$(PATH_SOURCES))
+
+TRAJC=$(BINDIR)/tools/trajc
+TRAJC_SRC=tools/trajc.cpp $(HOST_PATH_SRC)
+
+LINKED_ASSETS+=$(TRAJ_BINS)
+
+.PRECIOUS: $(BINDIR)/paths/%.traj
+
+$(TRAJC): $(TRAJC_SRC) $(wildcard $(INCDIR)/path/*.hpp) tools/host.hpp tools/json.hpp
+	$(VV)mkdir -p $(dir $@)
+	@echo "HOSTCXX $@"
+	$(VV)$(HOSTCXX) $(HOSTCXXFLAGS) -I$(INCDIR) $(TRAJC_SRC) -o $@
+
+$(BINDIR)/paths/%.traj: static/%.txt $(TRAJC)
+	$(VV)mkdir -p $(dir $@)
+	@echo "TRAJ $@"
+	$(VV)$(TRAJC) --rpm $(TRAJ_RPM) --wheel $(TRAJ_WHEEL) --track $(TRAJ_TRACK) --accel $(TRAJ_ACCEL) --dt $(TRAJ_DT) $< $@
@@ -10,5 +10,11 @@ void blue_stake_auto();
 void test_auto();
 void liam_skills();
 
+// Runs the drivetrain characterization tests and prints the fitted feedforward gains
+void characterize_drivetrain();
+
+// Loads every path the routines follow, call once from initialize()
+void load_paths();
+
 
 #endif // _AUTO_H_ 
\ No newline at end of file
@@ -1,6 +1,7 @@
 // config.hpp
 #include "pros/apix.h"
 #include "lemlib/api.hpp"
+#include "motion/chassis.hpp"
 
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
@@ -11,7 +12,18 @@ namespace robot {
     extern pros::Controller partnerController;
 
     namespace drivetrain {
-        extern lemlib::Chassis chassis;
+        extern motion::Chassis chassis;
+        extern motion::SettleCondition lateralSettle;
+        extern motion::SettleCondition angularSettle;
+        extern motion::TimeoutParams motionTimeouts;
+        extern pathing::ProfileLimits lateralProfile;
+        extern pathing::ProfileLimits angularProfile;
+        extern motion::VelocityControl velocityControl;
+        extern motion::GainSet goalGains;
+        extern float velocityKP;
+        extern pathing::SpeedLimits pathSpeedLimits;
+        extern motion::Feedforward leftFeedforward;
+        extern motion::Feedforward rightFeedforward;
     }
 
     namespace mechanisms {
@@ -23,6 +35,7 @@ namespace robot {
         extern pros::ADIDigitalOut clamp;
         extern pros::ADIDigitalOut doinker;
         extern pros::ADIDigitalOut intake;
+        bool clampClosed();
 
         // Sensors/Digital inputs
         extern pros::Rotation lbRotationSensor;
@@ -0,0 +1,832 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include "lemlib/api.hpp"
+#include "motion/drivetrain.hpp"
+#include "motion/feedforward.hpp"
+#include "motion/gains.hpp"
+#include "motion/handle.hpp"
+#include "motion/marker.hpp"
+#include "motion/settle.hpp"
+#include "motion/sysid.hpp"
+#include "motion/timeout.hpp"
+#include "path/profile.hpp"
+#include "path/pursuit.hpp"
+#include "path/ramsete.hpp"
+#include "path/registry.hpp"
+#include "path/speed.hpp"
+#include "path/trajectory.hpp"
+#include "path/transform.hpp"
+#include "path/view.hpp"
+
+namespace motion {
+/**
+ * @brief Parameters for Chassis::queueMoveToPoint() and Chassis::queueTurnToHeading()
+ */
+struct QueueParams {
+        /** whether the robot should move forwards or backwards. True by default */
+        bool forwards = true;
+        /** the maximum speed the robot can travel at. Value between 0-127. 127 by default */
+        float maxSpeed = 127;
+        /** distance from the target where the next queued move takes over, in inches. Not used by the last motion in
+         * the queue, or when the next motion can't carry on without stopping. 6 by default */
+        float blendRadius = 6;
+        /** heading error where the next queued move takes over from a turn, in degrees. 10 by default */
+        float blendAngle = 10;
+};
+
+/**
+ * @brief Parameters for Chassis::ramsete()
+ */
+struct RamseteParams {
+        /** whether the robot should drive the trajectory forwards or backwards. True by default */
+        bool forwards = true;
+        /** how hard position error is corrected, per square inch. 0.04 by default */
+        float b = 0.04;
+        /** damping of the correction, between 0 and 1. 0.7 by default */
+        float zeta = 0.7;
+};
+
+/**
+ * @brief How motions that plan wheel velocities drive the motors, see Chassis::setVelocityControl()
+ */
+enum class VelocityControl {
+    VOLTAGE, /** feedforward power, with the motion's feedback added as power. The default */
+    MOTOR, /** wheel velocity targets for the motors' own velocity loops, through move_velocity() */
+    LOOP /** wheel velocity targets, tracked with feedforward power and a loop on the measured wheel velocity */
+};
+
+/**
+ * @brief A motion waiting in the Chassis motion queue
+ */
+struct QueuedMotion {
+        enum class Type { POINT, HEADING };
+
+        Type type;
+        float x; /** target, POINT only */
+        float y; /** target, POINT only */
+        float theta; /** target heading in degrees, HEADING only */
+        int timeout;
+        QueueParams params;
+};
+
+/**
+ * @brief LemLib chassis extended with the project's own motions
+ *
+ * Everything LemLib provides is still available, motions defined here hide the LemLib versions of the same name.
+ */
+class Chassis : public lemlib::Chassis {
+    public:
+        using lemlib::Chassis::Chassis;
+
+        /**
+         * @brief Set the field transform applied to every pose, target and path passed to the chassis
+         *
+         * Lets one routine run on either alliance. Coordinates, headings and paths are transformed, and swing sides
+         * and turn directions are swapped when the transform mirrors the field. getPose() is not affected and always
+         * reports the robot's real position.
+         *
+         * @param transform the transform to apply
+         *
+         * @b Example
+         * @code {.cpp}
+         * // run the red routine on the blue side
+         * chassis.setFieldTransform(pathing::FieldTransform::FLIP_X);
+         * red_ring_auto();
+         * chassis.setFieldTransform(pathing::FieldTransform::NONE);
+         * @endcode
+         */
+        void setFieldTransform(pathing::FieldTransform transform);
+        /**
+         * @brief Get the current field transform
+         */
+        pathing::FieldTransform getFieldTransform() const;
+
+        /**
+         * @brief Drive moveToPoint and moveToPose along a motion profile instead of with the lateral PID alone
+         *
+         * The lateral PID drives straight at the target, so long moves saturate, overshoot and wait out the exit
+         * timeouts. A profiled move plans a trapezoidal (or, with a jerk limit, S-curve) velocity profile over the
+         * distance to the target when it starts. Each tick the profile's velocity and acceleration are fed forward
+         * (see setFeedforward()) and the lateral PID corrects how far the robot is behind the profile, then once the
+         * profile ends the lateral PID settles on the target with the usual exit conditions. The profile replaces the
+         * lateral slew.
+         *
+         * Moves with a minSpeed or an earlyExitRange are chained into the next motion and never stop, so they still use
+         * LemLib's controller.
+         *
+         * @param limits velocity, acceleration and jerk limits of the profile. A maxVelocity or maxAcceleration of 0
+         * turns profiling off, which is the default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // 60 in/s, reach it in half a second, S-curve
+         * chassis.setLateralProfile({60, 120, 600});
+         * @endcode
+         */
+        void setLateralProfile(pathing::ProfileLimits limits);
+        /**
+         * @brief Drive turns and swings along a motion profile instead of with the angular PID alone
+         *
+         * The angular PID turns hard at first, then creeps the last few degrees and waits out the exit conditions. A
+         * profiled turn plans a trapezoidal (or, with a jerk limit, S-curve) angular velocity profile through the
+         * turn when it starts, in the turn's direction. Each tick each side is fed the wheel velocity and acceleration
+         * the profile needs (see setFeedforward()) and the angular PID corrects how far the robot is behind the
+         * profile. Once the profile ends the angular PID settles on the heading with the angular settle condition
+         * (see setSettleConditions()), or the usual exit conditions if there isn't one.
+         *
+         * swingToHeading and swingToPoint are profiled too. A swing pivots on the locked side, which holds its
+         * position, so the moving wheel covers twice the distance per degree that it does turning in place. Swings
+         * follow half the angular limits, which keeps the moving wheel within the same speed and acceleration.
+         *
+         * Turns and swings with a minSpeed or an earlyExitRange are chained into the next motion and never stop, so
+         * they still use LemLib's controller.
+         *
+         * @param limits angular velocity, acceleration and jerk limits of the profile, in degrees per second, per
+         * second squared and per second cubed. A maxVelocity or maxAcceleration of 0 turns profiling off, which is the
+         * default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // 540 deg/s, reached in 0.2s
+         * chassis.setAngularProfile({540, 2700});
+         * @endcode
+         */
+        void setAngularProfile(pathing::ProfileLimits limits);
+
+        /**
+         * @brief Set the feedforward gains of each side of the drivetrain
+         *
+         * Motions that plan a velocity (profiled moves and trajectories) turn each side's planned velocity and
+         * acceleration into power with these gains and add the lateral and angular PID outputs on top, so the PID
+         * only corrects tracking error. Until gains are set, a model of the drivetrain at its free speed is used.
+         *
+         * @param left gains of the left side
+         * @param right gains of the right side
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.setFeedforward({6, 1.55, 0.18}, {6.5, 1.56, 0.19});
+         * @endcode
+         */
+        void setFeedforward(Feedforward left, Feedforward right);
+        /**
+         * @brief Set the same feedforward gains on both sides of the drivetrain
+         */
+        void setFeedforward(Feedforward both);
+        /**
+         * @brief Set how motions that plan wheel velocities drive the motors
+         *
+         * Profiled moves, turns and swings, trajectories and RAMSETE plan a velocity and acceleration for each wheel
+         * and correct it with feedback on the pose. By default the plan goes out as feedforward power (see
+         * setFeedforward()) with the feedback added as power, so anything the feedforward doesn't model, like battery
+         * sag or a mobile goal in the clamp, slows the robot down and stretches the motion. With a cascaded mode the
+         * feedback is turned into wheel velocity instead, and an inner velocity loop tracks the result:
+         * - MOTOR hands the wheel velocity to the motors' own 10ms velocity loops with move_velocity(). The motors
+         *   don't see the planned acceleration, so they lag the plan a little when it speeds up
+         * - LOOP keeps the feedforward power, and adds kP times the gap between the wheel velocity and the velocity
+         *   the motors measure
+         *
+         * Pure pursuit, the motion queue and LemLib's motions drive motor power as before.
+         *
+         * @param mode how the motors are driven
+         * @param kP power per inch per second of velocity error, LOOP only. 1 by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // keep trajectory timing when the battery is low
+         * chassis.setVelocityControl(motion::VelocityControl::LOOP, 1);
+         * @endcode
+         */
+        void setVelocityControl(VelocityControl mode, float kP = 1);
+        /**
+         * @brief Set the physical speed limits for following paths
+         *
+         * When a path starts, each point's speed is capped by the lateral acceleration its curvature allows and by
+         * braking in time for the points after it (see pathing::limitSpeeds()). The arc the robot drives back onto
+         * the path is not capped: slowing down on it also slows the turn back, and the robot drifts further off. The
+         * path's own speeds still apply where they are lower, so a path drawn fast everywhere slows down only where it
+         * has to. Trajectories are planned with their own limits and are not affected, and neither are paths of more
+         * than DECODE_CAPACITY points.
+         *
+         * @param limits the limits. Both are off by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // slow down for turns above 150 in/s^2 sideways, brake at 200 in/s^2
+         * chassis.setPathSpeedLimits({150, 200});
+         * @endcode
+         */
+        void setPathSpeedLimits(pathing::SpeedLimits limits);
+        /**
+         * @brief Set when moves and turns have settled on their target
+         *
+         * With no settle conditions, motions end on the small and large error exit conditions of the controller
+         * settings, so every move and turn waits out at least the small error timeout after arriving. Settle
+         * conditions can also use the measured velocity (see SettleCondition), so a motion can end as soon as the
+         * robot is stopped within tolerance. They replace the exit conditions in the profiled moves and turns and
+         * the motion queue. LemLib's own moveToPoint, moveToPose, turns and swings still run their exit conditions,
+         * and are also ended once the settle conditions are met. Motions with a minSpeed never settle and are left
+         * alone.
+         *
+         * @param lateral condition on the distance to the target, in inches, and the speed, in inches per second
+         * @param angular condition on the heading error, in degrees, and the turning rate, in degrees per second
+         *
+         * @b Example
+         * @code {.cpp}
+         * using motion::SettleCondition;
+         * // stopped within an inch or a degree, or the exit conditions of the controller settings
+         * chassis.setSettleConditions(
+         *     (SettleCondition::error(1) & SettleCondition::velocity(2, 30)) | SettleCondition::error(1, 100) |
+         *         SettleCondition::error(3, 500),
+         *     (SettleCondition::error(1) & SettleCondition::velocity(10, 30)) | SettleCondition::error(1, 100) |
+         *         SettleCondition::error(3, 500));
+         * @endcode
+         */
+        void setSettleConditions(SettleCondition lateral, SettleCondition angular);
+        /**
+         * @brief Set how timeouts are worked out for motions called with AUTO_TIMEOUT
+         *
+         * Every motion estimates how long it should take when it is called. Moves and turns use a kinematic model of
+         * the drivetrain built from the feedforward gains and the track width (see DurationModel), plus the settle
+         * time if they stop on the target. Profiled moves and turns use their profile, paths their speeds and
+         * trajectories their duration. A motion called with AUTO_TIMEOUT gets the expected duration times the
+         * margin, clamped to the minimum and maximum. Motions whose duration can't be estimated, like text paths, get
+         * the maximum.
+         *
+         * A motion called while another one is still running is estimated from where the running one ends. Every
+         * motion's handle reports its expected and actual duration (see MotionHandle::expectedTime()), and prints
+         * them to the terminal when it ends.
+         *
+         * @param params margin, settle time and limits of the automatic timeouts
+         *
+         * @b Example
+         * @code {.cpp}
+         * // 1.5 times the expected duration, with 300ms to settle, between 300ms and 5s
+         * chassis.setTimeoutParams({1.5, 300, 300, 5000});
+         * chassis.turnToHeading(90, motion::AUTO_TIMEOUT);
+         * @endcode
+         */
+        void setTimeoutParams(TimeoutParams params);
+        /**
+         * @brief Add a named set of gains the chassis can switch to, or replace the set with that name
+         *
+         * The robot handles very differently carrying a mobile goal, so one set of gains either oscillates with the
+         * goal or is sluggish without it. A gain set holds the controller settings (PID, exit ranges and slew), settle
+         * conditions and profile limits, and the chassis switches between sets as a whole. The gains the chassis was
+         * built with, together with setSettleConditions(), setLateralProfile() and setAngularProfile(), make up the
+         * set named "default".
+         *
+         * Each motion runs on the first set, in the order they were added, whose predicate holds when the motion
+         * starts, or else on the set last chosen with useGainSet(). Switching is bumpless: the set is only switched
+         * while no motion is running, so a motion keeps its gains to the end, even if a marker closes the clamp
+         * halfway through, and the next one starts its PIDs from rest on the new gains. Whether a move or turn is
+         * profiled is decided when it is called, from the set that would run if it started then.
+         *
+         * @param name what to call the set, for useGainSet()
+         * @param gains the gains
+         * @param when picks this set for every motion that starts while it returns true. None by default, so the set
+         * is only used once chosen with useGainSet()
+         *
+         * @b Example
+         * @code {.cpp}
+         * // heavier and slower to turn with a goal in the clamp
+         * chassis.addGainSet("goal", goalGains, []() { return clampClosed(); });
+         * @endcode
+         */
+        void addGainSet(const std::string& name, GainSet gains, std::function<bool()> when = nullptr);
+        /**
+         * @brief Run the next motions on a gain set, unless the predicate of another one holds
+         *
+         * @param name the set, "default" for the gains the chassis was built with
+         * @return false if there is no set with that name, and the chosen set is left as it was
+         */
+        bool useGainSet(const std::string& name);
+        /**
+         * @brief the name of the gain set of the running motion, or of the last one once it has ended
+         */
+        const std::string& getGainSet() const;
+
+        void setPose(float x, float y, float theta, bool radians = false);
+        void setPose(lemlib::Pose pose, bool radians = false);
+        /**
+         * @brief Cancel the running motion, see lemlib::Chassis::cancelMotion(). Its handle reports CANCELLED
+         */
+        void cancelMotion();
+        /**
+         * @brief Cancel the running motion and every queued one, see lemlib::Chassis::cancelAllMotions(). Their
+         * handles report CANCELLED
+         */
+        void cancelAllMotions();
+
+        /*
+         * The motions below take the same arguments as LemLib's and return a handle to the motion, which can be waited
+         * on instead of calling waitUntil() and waitUntilDone() on the chassis (see MotionHandle). Their timeout can
+         * be AUTO_TIMEOUT (see setTimeoutParams()).
+         */
+        MotionHandle turnToPoint(float x, float y, int timeout, lemlib::TurnToPointParams params = {},
+                                 bool async = true);
+        MotionHandle turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params = {},
+                                   bool async = true);
+        MotionHandle swingToHeading(float theta, lemlib::DriveSide lockedSide, int timeout,
+                                    lemlib::SwingToHeadingParams params = {}, bool async = true);
+        MotionHandle swingToPoint(float x, float y, lemlib::DriveSide lockedSide, int timeout,
+                                  lemlib::SwingToPointParams params = {}, bool async = true);
+        MotionHandle moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params = {},
+                                bool async = true);
+        MotionHandle moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params = {},
+                                 bool async = true);
+
+        /**
+         * @brief Follow a path using pure pursuit
+         *
+         * Binary path assets (see PATH_ASSET) are viewed in place in the asset buffer, compressed ones are decoded
+         * into a fixed buffer owned by the chassis once the motion starts, so nothing is allocated. Compressed paths
+         * of more than DECODE_CAPACITY points are skipped, follow them through a PathRegistry instead. Trajectory
+         * assets (see TRAJECTORY_ASSET) are followed by time instead of by searching for the closest point. Anything
+         * else is handed to LemLib's text based follower.
+         *
+         * @param path the path or trajectory asset to follow
+         * @param lookahead the lookahead distance. Units in inches. Larger values will make the robot move faster but
+         * will follow the path less accurately
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         *
+         * @b Example
+         * @code {.cpp}
+         * PATH_ASSET(RedRing1)
+         * chassis.follow(RedRing1_path, 8, 2500);
+         * @endcode
+         */
+        MotionHandle follow(const asset& path, float lookahead, int timeout, bool forwards = true,
+                            bool async = true);
+        /**
+         * @brief Follow a path using pure pursuit, with a lookahead that adapts to speed and curvature
+         *
+         * Like following with a fixed lookahead, but each tick the lookahead comes from the policy, for the speed of
+         * the closest point and the curvature of the stretch of path the lookahead spans. Trajectories and text paths
+         * are followed with maxLookahead throughout.
+         *
+         * @param path the path or trajectory asset to follow
+         * @param lookahead the lookahead policy
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         *
+         * @b Example
+         * @code {.cpp}
+         * PATH_ASSET(RedRing1)
+         * chassis.follow(RedRing1_path, pathing::LookaheadPolicy(), 2500);
+         * @endcode
+         */
+        MotionHandle follow(const asset& path, const pathing::LookaheadPolicy& lookahead, int timeout,
+                            bool forwards = true, bool async = true);
+        /**
+         * @brief Follow a path using pure pursuit
+         *
+         * The points are read in place through the view, nothing is copied or allocated while following.
+         *
+         * @param path view of the path to follow. The storage it points to must outlive the motion
+         * @param lookahead the lookahead distance. Units in inches
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         */
+        MotionHandle follow(pathing::PathView path, float lookahead, int timeout, bool forwards = true,
+                            bool async = true);
+        /**
+         * @brief Follow a path using pure pursuit, with a lookahead that adapts to speed and curvature
+         *
+         * @param path view of the path to follow. The storage it points to must outlive the motion
+         * @param lookahead the lookahead policy
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         */
+        MotionHandle follow(pathing::PathView path, const pathing::LookaheadPolicy& lookahead, int timeout,
+                            bool forwards = true, bool async = true);
+        /**
+         * @brief Follow a time parameterized trajectory
+         *
+         * The target each tick is the sample for the time since the motion started, so the robot drives the
+         * trajectory's velocity profile instead of the path's speed column, and no closest point search is needed.
+         * The robot steers towards the sample lookahead inches past the target, and the motion ends when the
+         * trajectory does.
+         *
+         * @param trajectory view of the trajectory to follow. The storage it points to must outlive the motion
+         * @param lookahead the lookahead distance. Units in inches
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param forwards whether the robot should follow the trajectory going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         *
+         * @b Example
+         * @code {.cpp}
+         * TRAJECTORY_ASSET(RedRing1)
+         * chassis.follow(RedRing1_traj, 8, 2500);
+         * @endcode
+         */
+        MotionHandle follow(pathing::TrajectoryView trajectory, float lookahead, int timeout, bool forwards = true,
+                            bool async = true);
+        /**
+         * @brief Track a time parameterized trajectory with a RAMSETE controller
+         *
+         * Like following a trajectory, the target each tick is the sample for the time since the motion started, but
+         * instead of steering at a point ahead the robot's position and heading error to the target itself are
+         * corrected, in the robot's frame. Nothing is cut off corners and the robot can't drift off the trajectory
+         * at speed the way it does with a lookahead. The corrected speeds are turned into power by the drivetrain's
+         * feedforward (see setFeedforward()), so measured gains make a real difference here. The motion ends when the
+         * trajectory does.
+         *
+         * @param trajectory view of the trajectory to track. The storage it points to must outlive the motion
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param params forwards, b and zeta
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         *
+         * @b Example
+         * @code {.cpp}
+         * TRAJECTORY_ASSET(RedRing1)
+         * chassis.ramsete(pathing::TrajectoryView::fromAsset(RedRing1_traj), 2500);
+         * @endcode
+         */
+        MotionHandle ramsete(pathing::TrajectoryView trajectory, int timeout, RamseteParams params = {},
+                             bool async = true);
+        /**
+         * @brief Track a trajectory loaded by a PathRegistry with a RAMSETE controller
+         *
+         * @param trajectory handle returned by PathRegistry::add() for a trajectory asset. The registry must have
+         * been loaded
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param params forwards, b and zeta
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         *
+         * @b Example
+         * @code {.cpp}
+         * pathing::PathHandle redRing1 = registry.add("RedRing1", RedRing1_traj);
+         * registry.load(pros::micros);
+         * chassis.ramsete(redRing1, 2500);
+         * @endcode
+         */
+        MotionHandle ramsete(pathing::PathHandle trajectory, int timeout, RamseteParams params = {},
+                             bool async = true);
+        /**
+         * @brief Follow a path or trajectory loaded by a PathRegistry
+         *
+         * The registry parsed, decoded and checked the asset when it loaded, so starting the motion costs nothing
+         * more than following a view.
+         *
+         * @param path handle returned by PathRegistry::add(). The registry must have been loaded
+         * @param lookahead the lookahead distance. Units in inches
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         *
+         * @b Example
+         * @code {.cpp}
+         * pathing::PathHandle rush = registry.add("RedStakeRush", RedStakeRush_path);
+         * registry.load(pros::micros);
+         * chassis.follow(rush, 10, 10000);
+         * @endcode
+         */
+        MotionHandle follow(pathing::PathHandle path, float lookahead, int timeout, bool forwards = true,
+                            bool async = true);
+        /**
+         * @brief Follow a path loaded by a PathRegistry, with a lookahead that adapts to speed and curvature
+         *
+         * @param path handle returned by PathRegistry::add(). The registry must have been loaded. Trajectories are
+         * followed with maxLookahead throughout
+         * @param lookahead the lookahead policy
+         * @param timeout the maximum time the robot can spend moving, or AUTO_TIMEOUT
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.follow(rush, pathing::LookaheadPolicy(), 10000);
+         * @endcode
+         */
+        MotionHandle follow(pathing::PathHandle path, const pathing::LookaheadPolicy& lookahead, int timeout,
+                            bool forwards = true, bool async = true);
+
+        /**
+         * @brief Attach a marker to the next motion
+         *
+         * Markers added before a motion call belong to that motion, and run from its task as it passes them. Paths,
+         * trajectories and the motion queue check them every tick with their own progress. LemLib's motions (turns,
+         * swings, moveToPoint, moveToPose and text paths) are watched by a task that polls the distance traveled, so
+         * INDEX markers on them only run when the motion ends, and FRACTION markers use the straight line distance to
+         * the target or the angle left to turn. Markers the motion didn't reach run when it settles or times out, and
+         * are dropped when it is cancelled, interrupted or skipped.
+         *
+         * @param marker the marker
+         *
+         * @b Example
+         * @code {.cpp}
+         * // close the clamp 21 inches into the move, without the routine waiting for it
+         * chassis.addMarker(motion::Marker::atDistance(21, []() { clamp.set_value(true); }));
+         * chassis.moveToPoint(-47, 26.03, 1000, {.forwards = false, .maxSpeed = 60});
+         * @endcode
+         */
+        void addMarker(Marker marker);
+
+        /**
+         * @brief Add a move to a point to the motion queue
+         *
+         * Queued motions run back to back as one motion once runQueue() is called. Instead of slowing to a stop (or to
+         * minSpeed) at each target and spinning up again, the robot hands over to the next move blendRadius inches
+         * from the target, slowing beforehand only as much as the corner needs, and keeps its current power and
+         * turning rate through the handoff. The last motion in the queue settles on its target with the usual exit
+         * conditions. A queued move turns towards its target before it drives, so no turnToPoint is needed.
+         *
+         * @param x x location
+         * @param y y location
+         * @param timeout longest time this move can take, in milliseconds, or AUTO_TIMEOUT
+         * @param params forwards, maxSpeed, blendRadius
+         *
+         * @b Example
+         * @code {.cpp}
+         * // sweep through two rings and settle on a third without stopping in between
+         * chassis.queueMoveToPoint(-21, 26, 1000);
+         * chassis.queueMoveToPoint(30, 50, 1500, {.blendRadius = 9});
+         * chassis.queueMoveToPoint(30, 50, 1000, {.maxSpeed = 70});
+         * chassis.runQueue();
+         * @endcode
+         */
+        void queueMoveToPoint(float x, float y, int timeout, QueueParams params = {});
+        /**
+         * @brief Add a turn in place to the motion queue
+         *
+         * If a move follows, it takes over once the heading is within blendAngle, still turning.
+         *
+         * @param theta heading in degrees
+         * @param timeout longest time this turn can take, in milliseconds, or AUTO_TIMEOUT
+         * @param params maxSpeed, blendAngle
+         */
+        void queueTurnToHeading(float theta, int timeout, QueueParams params = {});
+        /**
+         * @brief Run every queued motion as one motion, and empty the queue
+         *
+         * The handle's distance is measured from the start of the first queued motion, and it ends when the last one
+         * does.
+         *
+         * @param async whether the function should be run asynchronously. true by default
+         * @return a handle to the motion
+         */
+        MotionHandle runQueue(bool async = true);
+        /**
+         * @brief Drop every queued motion without running it
+         */
+        void clearQueue();
+
+        /**
+         * @brief Run a drivetrain characterization test
+         *
+         * Applies the test's voltage to both sides for the length of the test, and samples the voltage and each
+         * side's wheel velocity every 10ms. Every sample is also printed to the terminal (see
+         * include/motion/sysid.hpp), so a log of the tests can be fitted on the host with tools/sysid. The robot needs
+         * clear space in the direction it drives, forward tests followed by backward ones bring it back near where it
+         * started. The test always runs synchronously, and any other motion cancels it.
+         *
+         * @param test the test to run
+         * @param params ramp rate, step voltage and length of the tests
+         * @return the samples
+         *
+         * @b Example
+         * @code {.cpp}
+         * std::vector<motion::SysIdSample> samples = chassis.characterize(motion::SysIdTest::QUASISTATIC_FORWARD);
+         * motion::SysIdFit fit = motion::fitFeedforward(samples);
+         * @endcode
+         */
+        std::vector<SysIdSample> characterize(SysIdTest test, SysIdParams params = {});
+    protected:
+        /**
+         * @brief what a motion wants from one side of the drivetrain for a tick, see driveSides()
+         */
+        struct SideCommand {
+                float velocity = 0; /** planned wheel velocity, inches per second */
+                float acceleration = 0; /** planned wheel acceleration, inches per second squared */
+                float correction = 0; /** feedback on top of the plan, in motor power */
+                bool hold = false; /** hold the side where it is instead, like the locked side of a swing */
+        };
+
+        /**
+         * @brief error to a motion's target from a pose, with theta in degrees
+         */
+        using ErrorFunction = std::function<float(const lemlib::Pose& pose)>;
+
+        /**
+         * @brief pure pursuit on a path that is already in field coordinates
+         */
+        void purePursuit(pathing::PathView path, pathing::LookaheadPolicy lookahead, int timeout, bool forwards,
+                         bool async, MarkerList markers, MotionHandle handle);
+        /**
+         * @brief decode a compressed path asset into decodeBuffer and follow it
+         *
+         * The asset is only decoded once the motion has started, so the path being followed is never overwritten.
+         * Paths of more than DECODE_CAPACITY points are skipped.
+         */
+        void followCompressed(asset path, pathing::LookaheadPolicy lookahead, int timeout, bool forwards, bool async,
+                              MarkerList markers, MotionHandle handle);
+        /**
+         * @brief the pure pursuit loop. The motion must already be started, it is ended on return
+         */
+        void pursue(pathing::PathView path, const pathing::LookaheadPolicy& lookahead, int timeout, bool forwards,
+                    MarkerList& markers, const MotionHandle& handle);
+        /**
+         * @brief time indexed pursuit of a trajectory that is already in field coordinates
+         */
+        void trackTrajectory(pathing::TrajectoryView trajectory, float lookahead, int timeout, bool forwards,
+                             bool async, MarkerList markers, MotionHandle handle);
+        /**
+         * @brief RAMSETE tracking of a trajectory that is already in field coordinates
+         */
+        void ramseteTrack(pathing::TrajectoryView trajectory, int timeout, RamseteParams params, bool async,
+                          MarkerList markers, MotionHandle handle);
+        /**
+         * @brief run a list of queued motions, already in field coordinates, as one motion
+         */
+        void runMotions(std::vector<QueuedMotion> motions, bool async, MarkerList markers, MotionHandle handle);
+        /**
+         * @brief the feedforward gains of one side, or the free speed model if none were set
+         */
+        Feedforward sideFeedforward(lemlib::DriveSide side) const;
+        /**
+         * @brief drive both sides for a tick, the way setVelocityControl() asks
+         *
+         * Both sides are scaled down together if either would go faster than maxSpeed, out of 127
+         */
+        void driveSides(const SideCommand& left, const SideCommand& right, float maxSpeed);
+        /**
+         * @brief whether a motion with these settings should follow a profile with these limits
+         */
+        static bool profiled(const pathing::ProfileLimits& limits, float minSpeed, float earlyExitRange);
+        /**
+         * @brief wait for the chassis to be free, then take it for a motion like LemLib does, bump motionGeneration
+         * and switch to the gain set the motion should run on
+         *
+         * While a LemLib motion is watched this waits for the watch to end before queuing, so the watcher can't
+         * cancel this motion in place of its own
+         */
+        void requestMotionStart();
+        /**
+         * @brief the index of the gain set a motion starting now would run on
+         */
+        size_t pickGains() const;
+        /**
+         * @brief the gain set a motion called now will run on, as far as can be told before it starts
+         */
+        const GainSet& nextGains() const { return gainSets[pickGains()].gains; }
+        /**
+         * @brief switch to the gain set a motion starting now should run on. Only called from requestMotionStart()
+         * while it holds the chassis, since LemLib's motions read the PIDs and exit conditions as they run
+         */
+        void applyGains();
+        /**
+         * @brief drive to a point, or to a pose along the boomerang curve, following the lateral profile. The target
+         * is already in field coordinates
+         *
+         * @param theta target heading in degrees, NaN to drive to a point
+         * @param lead carrot point multiplier, pose only
+         */
+        void profiledMove(float x, float y, float theta, float lead, int timeout, bool forwards, float maxSpeed,
+                          bool async, MarkerList markers, MotionHandle handle);
+        /**
+         * @brief turn in place or swing to a heading, or to face a point, following the angular profile. The target
+         * is already in field coordinates
+         *
+         * @param theta target heading in degrees, NaN to face the point at x, y
+         * @param forwards whether the front of the robot faces the point, point only
+         * @param swing whether to swing around the locked side instead of turning in place
+         * @param lockedSide the side that holds still, swing only
+         */
+        void profiledTurn(float x, float y, float theta, bool forwards, lemlib::AngularDirection direction, bool swing,
+                          lemlib::DriveSide lockedSide, int timeout, float maxSpeed, bool async, MarkerList markers,
+                          MotionHandle handle);
+        /**
+         * @brief length of the curve a boomerang move drives, estimated as the quadratic Bezier from the start to the
+         * target with the first carrot point as its control point
+         *
+         * @param theta target heading in radians
+         */
+        static float boomerangLength(const lemlib::Pose& start, float x, float y, float theta, float lead);
+        /**
+         * @brief the kinematic model of the drivetrain that motion durations are estimated with
+         */
+        DurationModel durationModel() const;
+        /**
+         * @brief the expected duration of a motion in milliseconds, from its duration without settling in seconds
+         *
+         * @param settles whether the motion stops on its target, and so also takes the settle time
+         */
+        uint32_t expectedTime(float seconds, bool settles) const;
+        /**
+         * @brief where a motion called now will start, with theta in degrees. The end of the running motion if there
+         * is one, the robot's pose otherwise
+         */
+        lemlib::Pose expectedStart();
+        /**
+         * @brief take the markers added since the last motion call, for the motion being started
+         */
+        MarkerList takeMarkers();
+        /**
+         * @brief start a LemLib motion, and run its markers and update its handle from a task that watches
+         * distTraveled
+         *
+         * @param start starts the motion, asynchronously
+         * @param planned the distance the motion is expected to cover, for FRACTION markers. 0 if unknown
+         * @param timeout the motion's timeout, to tell a timeout from settling
+         * @param expected how long the motion should take, in milliseconds. 0 if unknown
+         * @param async whether to return once the motion has started, or wait for it to end
+         * @param lateralError distance to the target, to end the motion on the lateral settle condition. None if the
+         * motion doesn't settle on a position
+         * @param angularError heading error, to end the motion on the angular settle condition. None if the motion
+         * doesn't settle on a heading
+         */
+        MotionHandle watchMotion(const std::function<void()>& start, float planned, int timeout, uint32_t expected,
+                                 bool async, ErrorFunction lateralError = nullptr,
+                                 ErrorFunction angularError = nullptr);
+        /**
+         * @brief update the exit conditions of one of the project's motion loops, and whether they are met
+         *
+         * The settle condition is used if it has any tests, LemLib's small and large error exit conditions otherwise
+         */
+        static bool exitMet(SettleCondition& settle, lemlib::ExitCondition& smallExit,
+                            lemlib::ExitCondition& largeExit, float error, float velocity);
+        /**
+         * @brief how one of the project's motion loops ended
+         *
+         * @param settled whether the loop ended because the motion was done
+         * @param compState the competition status when the motion started
+         */
+        MotionResult loopResult(bool settled, int compState) const;
+
+        lemlib::AngularDirection transformDirection(lemlib::AngularDirection direction) const;
+        lemlib::DriveSide transformSide(lemlib::DriveSide side) const;
+
+        pathing::FieldTransform fieldTransform = pathing::FieldTransform::NONE;
+        Feedforward leftFeedforward;
+        Feedforward rightFeedforward;
+        VelocityControl velocityControl = VelocityControl::VOLTAGE;
+        /** power per inch per second of velocity error, VelocityControl::LOOP only */
+        float velocityKP = 1;
+        /** limits for profiled moves, off unless both limits are set */
+        pathing::ProfileLimits lateralProfile = {0, 0};
+        /** limits for profiled turns in degrees, off unless both limits are set */
+        pathing::ProfileLimits angularProfile = {0, 0};
+        /** markers for the next motion call */
+        MarkerList pendingMarkers;
+        /** motions waiting for runQueue(), in field coordinates */
+        std::vector<QueuedMotion> motionQueue;
+        /** most points of a compressed path followed straight from its asset. Longer ones go through a PathRegistry */
+        static constexpr size_t DECODE_CAPACITY = 2048;
+        /** decoded points of the compressed path being followed, allocated with the chassis */
+        alignas(pathing::Point) uint8_t decodeBuffer[DECODE_CAPACITY * sizeof(pathing::Point)];
+        /** when moves settle, LemLib's exit conditions are used if it has no tests */
+        SettleCondition lateralSettle;
+        /** when turns settle, LemLib's exit conditions are used if it has no tests */
+        SettleCondition angularSettle;
+        /** how motions called with AUTO_TIMEOUT get their timeout */
+        TimeoutParams timeoutParams;
+        /** where the last motion called ends, with theta in degrees. Where the next one is estimated from if the last
+         * one is still running */
+        lemlib::Pose plannedEnd = {0, 0, 0};
+        /** bumped by every cancel, so LemLib motions can tell they were cancelled */
+        uint32_t cancelCount = 0;
+        /** bumped by cancelAllMotions(), so motions waiting for a watch to end can tell they were cancelled too */
+        uint32_t cancelAllCount = 0;
+        /** bumped by every motion that takes the chassis, so a LemLib motion's watcher can tell it has been replaced */
+        uint32_t motionGeneration = 0;
+        /** generation of the LemLib motion being watched, 0 if none. No other motion takes the chassis until its
+         * watch has ended */
+        uint32_t watchedGeneration = 0;
+        /**
+         * @brief a gain set, with the name it was added under and its predicate
+         */
+        struct NamedGainSet {
+                std::string name;
+                GainSet gains;
+                std::function<bool()> when;
+        };
+        /** the sets of gains the chassis can switch between, "default" first. Built from the constructor's settings */
+        std::vector<NamedGainSet> gainSets = {{"default", {lateralSettings, angularSettings}, nullptr}};
+        /** the gain set chosen with useGainSet() */
+        size_t chosenGains = 0;
+        /** the gain set the chassis is on */
+        size_t activeGains = 0;
+        /** physical limits on the speed of followed paths, off unless set */
+        pathing::SpeedLimits pathSpeedLimits;
+        /** capped speed of each point of the path being followed, allocated with the chassis. Paths of more than
+         * DECODE_CAPACITY points are followed at their own speeds */
+        float speedBuffer[DECODE_CAPACITY];
+};
+} // namespace motion
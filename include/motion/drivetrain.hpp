@@ -0,0 +1,19 @@
+#pragma once
+
+#include "lemlib/chassis/chassis.hpp"
+#include "pros/abstract_motor.hpp"
+
+namespace motion {
+/**
+ * @brief free speed of a motor cartridge, in rpm
+ *
+ * @return 100, 200 or 600. 0 if the gearing can't be read, which is what an unplugged motor reports, so callers leave
+ * the motor out or fall back on voltage
+ */
+float cartridgeRpm(pros::MotorGears gears);
+
+/**
+ * @brief how fast the wheels of a drivetrain move at full power, inches per second
+ */
+float wheelSpeed(const lemlib::Drivetrain& drivetrain);
+} // namespace motion
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace motion {
+/**
+ * @brief Feedforward gains of one side of the drivetrain
+ *
+ * Turns a wheel velocity and acceleration into the motor power that should produce them, so feedback only has to
+ * correct what the model gets wrong. Power is in the usual -127 to 127 units, velocities are in inches per second.
+ *
+ * @b Example
+ * @code {.cpp}
+ * motion::Feedforward left(6, 1.55, 0.18);
+ * float power = left.power(40, 100); // 40 in/s, speeding up at 100 in/s^2
+ * @endcode
+ */
+struct Feedforward {
+        float kS = 0; /** power to overcome static friction */
+        float kV = 0; /** power per inch per second */
+        float kA = 0; /** power per inch per second squared */
+
+        /**
+         * @brief whether any gain is set
+         */
+        bool enabled() const { return kS != 0 || kV != 0 || kA != 0; }
+
+        /**
+         * @brief the power for a wheel velocity and acceleration
+         */
+        float power(float velocity, float acceleration) const {
+            // static friction opposes the direction of travel, or the push when starting from rest
+            const float direction = velocity != 0 ? velocity : acceleration;
+            const float sign = direction > 0 ? 1 : direction < 0 ? -1 : 0;
+            return kS * sign + kV * velocity + kA * acceleration;
+        }
+};
+} // namespace motion
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "lemlib/chassis/chassis.hpp"
+#include "motion/settle.hpp"
+#include "path/profile.hpp"
+
+namespace motion {
+/**
+ * @brief Everything that tunes how the chassis drives to a target, switched together by Chassis::useGainSet()
+ *
+ * @b Example
+ * @code {.cpp}
+ * // carrying a mobile goal: softer turns with more damping
+ * motion::GainSet goal {
+ *     {10, 0, 9, 3, 1, 100, 3, 500, 20}, // lateral PID, exit ranges and slew
+ *     {1.6, 0, 14, 3, 1, 100, 3, 500, 0}, // angular PID, exit ranges and slew
+ *     lateralSettle,
+ *     angularSettle,
+ *     {60, 150, 1500}, // lateral profile
+ *     {400, 1800} // angular profile, in degrees
+ * };
+ * @endcode
+ */
+struct GainSet {
+        /** PID, windup range, exit ranges and slew of moves */
+        lemlib::ControllerSettings lateral;
+        /** PID, windup range, exit ranges and slew of turns and swings */
+        lemlib::ControllerSettings angular;
+        /** when moves settle, see Chassis::setSettleConditions(). The exit conditions are used if it has no tests */
+        SettleCondition lateralSettle;
+        /** when turns settle, see Chassis::setSettleConditions() */
+        SettleCondition angularSettle;
+        /** limits of profiled moves, see Chassis::setLateralProfile(). Off unless both limits are set */
+        pathing::ProfileLimits lateralProfile = {0, 0};
+        /** limits of profiled turns in degrees, see Chassis::setAngularProfile(). Off unless both limits are set */
+        pathing::ProfileLimits angularProfile = {0, 0};
+};
+} // namespace motion
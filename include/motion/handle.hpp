@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace motion {
+/**
+ * @brief How a motion ended
+ */
+enum class MotionResult {
+    RUNNING, /** the motion hasn't ended yet, or hasn't started */
+    SETTLED, /** the exit conditions were met, or the path or trajectory ran to its end */
+    TIMEOUT, /** the motion ran out of time */
+    CANCELLED, /** cancelMotion() or cancelAllMotions() stopped it, or it was cancelled before it started */
+    INTERRUPTED, /** the competition mode changed */
+    SKIPPED /** the motion never ran, its path or trajectory couldn't be loaded */
+};
+
+/**
+ * @brief A handle to one motion, returned by every motion call
+ *
+ * Waiting on a handle blocks the calling task until the motion gets far enough or ends, and the motion wakes it with a
+ * task notification the tick that happens, instead of the caller polling. Handles are cheap to copy and stay valid
+ * after the motion ends. Motions run by LemLib (turns, swings, moveToPoint and moveToPose that aren't profiled, and
+ * text paths) are watched by a task that polls every 10ms, which is what wakes waiters on them.
+ *
+ * Waiting uses the calling task's notification value, so don't wait on a handle from a task that uses notifications
+ * for something else.
+ *
+ * @b Example
+ * @code {.cpp}
+ * motion::MotionHandle move = chassis.moveToPoint(-19, 25, 2000, {.forwards = false});
+ * move.waitUntil(30);
+ * clamp.set_value(true);
+ * if (move.waitUntilDone() == motion::MotionResult::TIMEOUT) pros::lcd::print(0, "clamp move timed out");
+ * pros::lcd::print(1, "took %d ms, expected %d ms", int(move.elapsedTime()), int(move.expectedTime()));
+ * @endcode
+ */
+class MotionHandle {
+    public:
+        /**
+         * @brief Construct the handle of a motion that hasn't started
+         */
+        MotionHandle();
+
+        /**
+         * @brief a handle to a motion that ended before it started
+         */
+        static MotionHandle ended(MotionResult result);
+
+        /**
+         * @brief wait until the motion has traveled a distance, or has ended
+         *
+         * @param distance inches since the motion started, as Chassis::waitUntil() measures it
+         * @param timeout longest time to wait, in milliseconds. Forever by default
+         * @return whether the motion traveled the distance. False if it ended short of it, or the wait timed out
+         */
+        bool waitUntil(float distance, uint32_t timeout = UINT32_MAX) const;
+
+        /**
+         * @brief wait until the motion ends
+         *
+         * @param timeout longest time to wait, in milliseconds. Forever by default
+         * @return how the motion ended, RUNNING if the wait timed out
+         */
+        MotionResult waitUntilDone(uint32_t timeout = UINT32_MAX) const;
+
+        /**
+         * @brief whether the motion has ended
+         */
+        bool done() const { return result() != MotionResult::RUNNING; }
+
+        /**
+         * @brief how the motion ended, RUNNING until it does
+         */
+        MotionResult result() const;
+
+        /**
+         * @brief inches the motion has traveled so far, or in total once it has ended
+         */
+        float distance() const;
+
+        /**
+         * @brief how long the motion was expected to take, in milliseconds. 0 if it couldn't be estimated, or hasn't
+         * started
+         */
+        uint32_t expectedTime() const;
+
+        /**
+         * @brief how long the motion has been running, or ran for once it has ended, in milliseconds
+         */
+        uint32_t elapsedTime() const;
+
+        /**
+         * @brief mark the motion as started now. Called by the motion once it has the chassis
+         *
+         * @param expected how long the motion should take, in milliseconds. 0 if unknown
+         */
+        void start(uint32_t expected) const;
+
+        /**
+         * @brief report how far the motion has traveled, and wake the tasks waiting for that distance. Called by the
+         * motion each tick
+         */
+        void update(float distance) const;
+
+        /**
+         * @brief end the motion, and wake every task waiting on it. Only the first call has any effect
+         *
+         * A motion that started prints its expected and actual duration to the terminal, as
+         * `motion,<expected ms>,<actual ms>,<result>`.
+         */
+        void finish(MotionResult result) const;
+    private:
+        struct State;
+
+        /**
+         * @brief block until the motion reaches a distance or ends, or the wait times out
+         *
+         * @return false if the wait timed out
+         */
+        bool wait(float distance, uint32_t timeout) const;
+
+        std::shared_ptr<State> state;
+};
+
+/**
+ * @brief the name of a motion result, for logging
+ */
+const char* toString(MotionResult result);
+} // namespace motion
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "motion/handle.hpp"
+
+namespace motion {
+/**
+ * @brief An action run from the motion task once a motion gets far enough
+ *
+ * The motion checks its markers every tick, so an action runs at most one tick (10ms) after its marker is reached and
+ * the routine doesn't have to wake up to poll. Actions run on the motion task and should return quickly, set an
+ * output or start a task rather than wait.
+ */
+struct Marker {
+        enum class Trigger {
+            DISTANCE, /** inches traveled since the motion started, as waitUntil() measures it */
+            INDEX, /** index of the closest path point, the current trajectory sample or the current queued motion */
+            FRACTION /** how much of the motion is done, from 0 to 1 */
+        };
+
+        Trigger trigger;
+        float value;
+        std::function<void()> action;
+        bool fired = false;
+
+        /**
+         * @brief run an action once the robot has traveled some distance
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.addMarker(motion::Marker::atDistance(21, []() { clamp.set_value(true); }));
+         * chassis.moveToPoint(-47, 26, 1000, {.forwards = false});
+         * @endcode
+         */
+        static Marker atDistance(float inches, std::function<void()> action) {
+            return {Trigger::DISTANCE, inches, std::move(action)};
+        }
+
+        /**
+         * @brief run an action once the motion reaches a path point, trajectory sample or queued motion
+         *
+         * @warning For paths the index counts the points of the compiled path. These are the rows of the JerryIO export
+         * unless the path opts in to resampling with PATH_TOLERANCE_<name> (see firmware/path-asset.mk), which picks
+         * new points off a spline through the rows, so a row no longer maps to a point. Use atDistance() or
+         * atFraction() on resampled paths. For trajectories the index counts 10ms samples, and for the motion queue it
+         * counts queued motions, starting at 0.
+         */
+        static Marker atIndex(size_t index, std::function<void()> action) {
+            return {Trigger::INDEX, float(index), std::move(action)};
+        }
+
+        /**
+         * @brief run an action once a fraction of the motion is done
+         */
+        static Marker atFraction(float fraction, std::function<void()> action) {
+            return {Trigger::FRACTION, fraction, std::move(action)};
+        }
+};
+
+/**
+ * @brief The markers of one motion
+ */
+class MarkerList {
+    public:
+        void add(Marker marker) { markers.push_back(std::move(marker)); }
+
+        bool empty() const { return markers.empty(); }
+
+        /**
+         * @brief run the action of every marker that has been reached and hasn't run yet. Called by the motion each
+         * tick
+         *
+         * @param distance inches traveled since the motion started
+         * @param index index of the closest path point, trajectory sample or queued motion
+         * @param fraction how much of the motion is done, from 0 to 1
+         */
+        void update(float distance, size_t index, float fraction) {
+            for (Marker& marker : markers) {
+                if (marker.fired) continue;
+                switch (marker.trigger) {
+                    case Marker::Trigger::DISTANCE: marker.fired = distance >= marker.value; break;
+                    case Marker::Trigger::INDEX: marker.fired = float(index) >= marker.value; break;
+                    case Marker::Trigger::FRACTION: marker.fired = fraction >= marker.value; break;
+                }
+                if (marker.fired && marker.action) marker.action();
+            }
+        }
+
+        /**
+         * @brief end the markers with the motion. Called by every motion as it ends, with its result
+         *
+         * A motion that settles or times out runs the actions it didn't reach, so one that exits a little early still
+         * closes the clamp. A motion that was cancelled, interrupted or skipped drops them: when autonomous ends
+         * mid-motion, its actions must not fire at the start of driver control
+         *
+         * @param result how the motion ended
+         */
+        void finish(MotionResult result) {
+            const bool flush = result == MotionResult::SETTLED || result == MotionResult::TIMEOUT;
+            for (Marker& marker : markers) {
+                if (flush && !marker.fired && marker.action) marker.action();
+                marker.fired = true;
+            }
+        }
+    private:
+        std::vector<Marker> markers;
+};
+} // namespace motion
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace motion {
+/**
+ * @brief When a motion has settled on its target
+ *
+ * LemLib's exit conditions only check that the error stays within a range for a time, so every motion waits out at
+ * least the small error timeout after it arrives, even when the robot stopped on the target straight away. A settle
+ * condition can also check the measured velocity and how fast the error is changing, so a motion can end the tick the
+ * robot is stopped within tolerance. Conditions combine with & (both must be met) and | (either is enough).
+ *
+ * Each test is met once it has held for its time, so a time of 0 is met the first tick it holds. Once the whole
+ * condition is met it stays met until reset().
+ *
+ * @b Example
+ * @code {.cpp}
+ * // stopped within an inch, falling back on LemLib's small and large error timeouts
+ * motion::SettleCondition settle = (motion::SettleCondition::error(1) & motion::SettleCondition::velocity(2, 30)) |
+ *                                  motion::SettleCondition::error(1, 100) | motion::SettleCondition::error(3, 500);
+ * @endcode
+ */
+class SettleCondition {
+    public:
+        /**
+         * @brief Construct a condition with no tests, which is never met
+         */
+        SettleCondition() = default;
+
+        /**
+         * @brief the error is within range, like lemlib::ExitCondition
+         *
+         * @param range largest error, in inches or degrees
+         * @param time how long the error has to stay within range, in milliseconds
+         */
+        static SettleCondition error(float range, uint32_t time = 0);
+        /**
+         * @brief the robot is moving slower than range
+         *
+         * @param range fastest velocity, in inches per second or degrees per second
+         * @param time how long the robot has to stay that slow, in milliseconds
+         */
+        static SettleCondition velocity(float range, uint32_t time = 0);
+        /**
+         * @brief the error is changing slower than range
+         *
+         * @param range fastest change of the error, in inches per second or degrees per second
+         * @param time how long the error has to change that slowly, in milliseconds
+         */
+        static SettleCondition errorRate(float range, uint32_t time = 0);
+
+        /**
+         * @brief both conditions are met
+         */
+        SettleCondition operator&(const SettleCondition& other) const;
+        /**
+         * @brief either condition is met
+         */
+        SettleCondition operator|(const SettleCondition& other) const;
+
+        /**
+         * @brief whether the condition has no tests
+         */
+        bool empty() const { return nodes.empty(); }
+
+        /**
+         * @brief update the condition, called by the motion every tick
+         *
+         * @param error distance or angle to the target
+         * @param velocity measured speed or turning rate of the robot
+         * @param time milliseconds, from any fixed point
+         * @return whether the condition has been met
+         */
+        bool update(float error, float velocity, uint32_t time);
+
+        /**
+         * @brief whether the condition has been met
+         */
+        bool met() const { return done; }
+
+        /**
+         * @brief forget every update, for the start of a motion
+         */
+        void reset();
+    private:
+        enum class Kind { ERROR, VELOCITY, ERROR_RATE, AND, OR };
+
+        struct Node {
+                Kind kind;
+                float range; /** tests only */
+                uint32_t time; /** tests only */
+                size_t left; /** AND and OR only, index of the first operand */
+                size_t right; /** AND and OR only, index of the second operand */
+                bool holding = false; /** whether the test held last tick */
+                uint32_t since = 0; /** when the test started holding */
+        };
+
+        static SettleCondition test(Kind kind, float range, uint32_t time);
+        SettleCondition combine(Kind kind, const SettleCondition& other) const;
+        /**
+         * @brief update every test below a node, and whether the node is met
+         */
+        bool evaluate(size_t node, float error, float velocity, float rate, uint32_t time);
+
+        /** the tests and the operators combining them, each operator after its operands. The last node is the root */
+        std::vector<Node> nodes;
+        bool done = false;
+        bool started = false;
+        float lastError = 0;
+        uint32_t lastTime = 0;
+};
+} // namespace motion
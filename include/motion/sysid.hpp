@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "motion/feedforward.hpp"
+
+/**
+ * Drivetrain characterization
+ *
+ * Chassis::characterize() runs one test on the robot and prints every sample as a line of the form
+ *
+ *   sysid,<time s>,<voltage V>,<left in/s>,<right in/s>
+ *
+ * so the terminal output can be saved and fitted on the host with tools/sysid.cpp, or fitted on the brain with
+ * fitFeedforward(). Nothing here uses PROS, the fit builds for both.
+ */
+namespace motion {
+/**
+ * @brief The characterization tests
+ *
+ * Quasistatic tests ramp the voltage slowly, so the robot barely accelerates and kS and kV can be read off. Dynamic
+ * tests apply a voltage step, which is where kA shows up.
+ */
+enum class SysIdTest { QUASISTATIC_FORWARD, QUASISTATIC_BACKWARD, DYNAMIC_FORWARD, DYNAMIC_BACKWARD };
+
+/**
+ * @brief Parameters of the characterization tests
+ */
+struct SysIdParams {
+        /** how fast quasistatic tests raise the voltage, volts per second. 0.75 by default */
+        float rampRate = 0.75;
+        /** voltage of dynamic tests. 7 by default */
+        float stepVoltage = 7;
+        /** length of a quasistatic test, seconds. Keep the robot on the field: at 0.75 V/s a 6 s test covers about
+         * 60". 6 by default */
+        float quasistaticTime = 6;
+        /** length of a dynamic test, seconds. 1.5 by default */
+        float dynamicTime = 1.5;
+};
+
+/**
+ * @brief One reading of a characterization test
+ */
+struct SysIdSample {
+        float time; /** seconds since the test started */
+        float voltage; /** volts applied to both sides */
+        float leftVelocity; /** inches per second */
+        float rightVelocity; /** inches per second */
+};
+
+/**
+ * @brief Drivetrain constants fitted from characterization tests
+ */
+struct SysIdFit {
+        Feedforward left; /** in motor power units, ready for Chassis::setFeedforward() */
+        Feedforward right; /** in motor power units, ready for Chassis::setFeedforward() */
+        float leftR2 = 0; /** fraction of the variation in power the left model explains, 1 is a perfect fit */
+        float rightR2 = 0; /** fraction of the variation in power the right model explains */
+        float maxVelocity = 0; /** inches per second at full power, from the fit */
+        float maxAcceleration = 0; /** highest acceleration measured, inches per second squared */
+        size_t samples = 0; /** samples the fit used */
+};
+
+/**
+ * @brief the voltage a test applies at a time since it started, 0 once it is over
+ */
+float sysIdVoltage(SysIdTest test, float time, const SysIdParams& params);
+
+/**
+ * @brief how long a test runs, seconds
+ */
+float sysIdDuration(SysIdTest test, const SysIdParams& params);
+
+/**
+ * @brief fit kS, kV and kA of each side to the samples of one or more tests, by least squares
+ *
+ * Acceleration is the slope of the velocity over the samples either side. Tests are told apart by their time
+ * starting over, so the samples of several tests can be passed in one list. Samples where a side is at rest are left
+ * out of that side's fit, since static friction can hold any voltage below kS.
+ *
+ * @b Example
+ * @code {.cpp}
+ * std::vector<motion::SysIdSample> samples = chassis.characterize(motion::SysIdTest::QUASISTATIC_FORWARD);
+ * ...
+ * motion::SysIdFit fit = motion::fitFeedforward(samples);
+ * chassis.setFeedforward(fit.left, fit.right);
+ * @endcode
+ */
+SysIdFit fitFeedforward(const std::vector<SysIdSample>& samples);
+} // namespace motion
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include "motion/feedforward.hpp"
+
+namespace motion {
+/**
+ * @brief Pass as the timeout of any motion to have the chassis work one out from how long the motion should take
+ *
+ * @b Example
+ * @code {.cpp}
+ * chassis.moveToPoint(-47, 26, motion::AUTO_TIMEOUT, {.forwards = false, .maxSpeed = 60});
+ * @endcode
+ */
+constexpr int AUTO_TIMEOUT = -1;
+
+/**
+ * @brief How automatic timeouts are worked out from the expected duration of a motion, see
+ * Chassis::setTimeoutParams()
+ */
+struct TimeoutParams {
+        float margin = 1.5; /** timeout as a multiple of the expected duration */
+        uint32_t settleTime = 300; /** milliseconds a motion that stops on its target is expected to take settling */
+        uint32_t minimum = 300; /** shortest automatic timeout, in milliseconds */
+        /** longest automatic timeout, and the timeout of motions whose duration can't be estimated, in milliseconds */
+        uint32_t maximum = 5000;
+
+        /**
+         * @brief the timeout of a motion
+         *
+         * @param timeout the timeout the motion was called with, in milliseconds, or AUTO_TIMEOUT
+         * @param expected how long the motion should take, in milliseconds. 0 if unknown
+         */
+        int resolve(int timeout, uint32_t expected) const;
+};
+
+/**
+ * @brief Kinematic model of how long motions take
+ *
+ * Each wheel is modeled with its feedforward gains, so at a power it tops out at (power - kS) / kV and speeds up at
+ * up to (power - kS) / kA. A move drives both wheels the same distance, a turn drives them in opposite directions
+ * around the robot's center and a swing drives one wheel around the other. The time to cover that distance from rest
+ * to rest is a trapezoidal profile at those limits. Settling on the target isn't included.
+ *
+ * @b Example
+ * @code {.cpp}
+ * motion::DurationModel model({0, 1.66, 0.166}, 11);
+ * float seconds = model.move(48) + model.turn(90, 80);
+ * @endcode
+ */
+class DurationModel {
+    public:
+        /**
+         * @brief Construct a model that can't estimate anything, every duration is 0
+         */
+        DurationModel() = default;
+        /**
+         * @param feedforward gains of an average wheel
+         * @param trackWidth distance between the left and right wheels, in inches
+         */
+        DurationModel(Feedforward feedforward, float trackWidth);
+
+        /**
+         * @brief seconds to drive a distance, in inches, at a power from 0 to 127
+         */
+        float move(float distance, float power = 127) const;
+        /**
+         * @brief seconds to turn in place through an angle, in degrees, at a power from 0 to 127
+         */
+        float turn(float degrees, float power = 127) const;
+        /**
+         * @brief seconds to swing around one locked side through an angle, in degrees, at a power from 0 to 127
+         */
+        float swing(float degrees, float power = 127) const;
+    private:
+        Feedforward feedforward;
+        float trackWidth = 0;
+};
+} // namespace motion
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "lemlib/asset.hpp"
+
+/**
+ * Packed binary path format
+ *
+ * Path files in static/ are compiled on the host at build time (see tools/pathc.cpp and
+ * firmware/path-asset.mk) into the following little-endian layout:
+ *
+ *   offset  size  field
+ *   0       4     magic, the bytes "LPTH"
+ *   4       2     format version
+ *   6       2     flags, see FLAG_HEADING and FLAG_COMPRESSED
+ *   8       4     point count
+ *   12      4     FNV-1a checksum of the point data
+ *   16      ...   point data, count * {float32 x, float32 y, float32 speed[, float32 heading]}, or the compressed
+ *                 stream described at FLAG_COMPRESSED
+ *
+ * The brain never parses text for these assets, it only checks the header and checksum. Uncompressed paths are read in
+ * place, compressed paths are decoded once into a buffer (see decode() in include/path/view.hpp).
+ */
+namespace pathing {
+
+constexpr uint8_t MAGIC[4] = {'L', 'P', 'T', 'H'};
+constexpr uint16_t VERSION = 1;
+
+/**
+ * @brief each point is followed by a float32 heading in degrees, NaN for points without one
+ */
+constexpr uint16_t FLAG_HEADING = 1 << 0;
+
+/**
+ * @brief the point data is a stream of LEB128 varints instead of floats
+ *
+ * Values are fixed point, in steps of 1 / QUANTUM. For each point, the changes in x, y and speed from the previous
+ * point (from 0 for the first point) are stored zig-zag encoded. If FLAG_HEADING is also set, each point then has its
+ * heading, zig-zag encoded plus 1, or 0 if it has none. The stream is as long as the rest of the asset.
+ */
+constexpr uint16_t FLAG_COMPRESSED = 1 << 1;
+
+/**
+ * @brief fixed point steps per inch, unit of speed and degree in compressed paths. Matches the 3 decimal places
+ * path.jerryio exports, so points taken straight from the text are stored exactly and resampled ones are within
+ * half a step
+ */
+constexpr float QUANTUM = 1000;
+
+struct __attribute__((__packed__)) Header {
+        uint8_t magic[4];
+        uint16_t version;
+        uint16_t flags;
+        uint32_t count;
+        uint32_t checksum;
+};
+
+static_assert(sizeof(Header) == 16, "path header must be 16 bytes");
+
+struct Point {
+        float x;
+        float y;
+        float speed;
+};
+
+static_assert(sizeof(Point) == 12, "path points must be packed float triples");
+
+enum class LoadResult {
+    OK,
+    NOT_BINARY, /** asset does not start with the path magic, probably a text path */
+    BAD_VERSION, /** asset was built by an incompatible version of pathc */
+    TRUNCATED, /** asset is shorter than the header claims */
+    BAD_CHECKSUM, /** point data does not match the checksum in the header */
+    COMPRESSED, /** asset is compressed and can't be viewed in place, decode it first */
+    BUFFER_TOO_SMALL, /** the buffer given to decode the asset into is too small */
+    NO_POINTS /** text path has no points that could be parsed */
+};
+
+/**
+ * @brief size in bytes of one point, given the header flags
+ */
+constexpr size_t pointSize(uint16_t flags) {
+    return sizeof(Point) + (flags & FLAG_HEADING ? sizeof(float) : 0);
+}
+
+/**
+ * @brief get a human readable name for a load result
+ */
+const char* toString(LoadResult result);
+
+/**
+ * @brief 32 bit FNV-1a hash, used as the point data checksum
+ */
+uint32_t checksum(const uint8_t* data, size_t size);
+
+/**
+ * @brief check whether an asset starts with the binary path magic
+ */
+bool isBinary(const asset& path);
+
+/**
+ * @brief check whether an asset is a binary path with compressed points, which has to be decoded to be viewed
+ */
+bool isCompressed(const asset& path);
+
+/**
+ * @brief validate the header and checksum of a binary path asset
+ *
+ * @param path the asset to validate
+ * @param header filled with a copy of the header if the asset is valid
+ * @return LoadResult::OK if the asset can be read
+ */
+LoadResult validate(const asset& path, Header* header = nullptr);
+
+/**
+ * @brief encode a list of points into the binary path format
+ *
+ * @param points the points
+ * @param headings heading of each point in degrees, or NaN. If empty, no heading column is stored
+ * @param compress whether to store the points compressed (see FLAG_COMPRESSED). false by default
+ */
+std::vector<uint8_t> encode(const std::vector<Point>& points, const std::vector<float>& headings = {},
+                            bool compress = false);
+} // namespace pathing
+
+/**
+ * @brief declare a compiled path asset
+ *
+ * static/<name>.txt is compiled to a binary path and declared as <name>_path
+ *
+ * @b Example
+ * @code {.cpp}
+ * PATH_ASSET(RedRing1)
+ * chassis.follow(RedRing1_path, 8, 2500);
+ * @endcode
+ */
+#define PATH_ASSET(x)                                                                                                  \
+    extern "C" {                                                                                                       \
+    extern uint8_t _binary_paths_##x##_path_start[], _binary_paths_##x##_path_size[];                                  \
+    static asset x##_path = {_binary_paths_##x##_path_start, (size_t)_binary_paths_##x##_path_size};                   \
+    }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+
+namespace pathing {
+/**
+ * @brief Text formats exported by path.jerryio
+ */
+enum class TextFormat {
+    LEMLIB_V05, /** "x, y, speed" rows terminated by endData */
+    JERRYIO_V01 /** "#PATH-POINTS-START name" followed by "x,y,speed[,heading]" rows */
+};
+
+/**
+ * @brief A point read from a text path
+ */
+struct TextPoint {
+        float x;
+        float y;
+        float speed;
+        float heading; /** NaN when the row has no heading column */
+};
+
+/**
+ * @brief Streaming parser for path.jerryio text exports
+ *
+ * The format is detected from the header line, if any. Points are read one row at a time straight from the buffer,
+ * which does not need to be null terminated, and nothing is allocated. Parsing stops at the end of the point data
+ * (endData, or the next line starting with #), so the JSON trailer JerryIO appends is never scanned. Only the first
+ * path of a multi path JerryIO export is read.
+ *
+ * @b Example
+ * @code {.cpp}
+ * pathing::TextParser parser(text, text + size);
+ * pathing::TextPoint point;
+ * pathing::TextParser::Status status;
+ * while ((status = parser.next(point)) != pathing::TextParser::Status::END) {
+ *     if (status == pathing::TextParser::Status::POINT) {
+ *         // use point
+ *     }
+ * }
+ * @endcode
+ */
+class TextParser {
+    public:
+        enum class Status {
+            POINT, /** a point was read */
+            MALFORMED, /** the row could not be read and was skipped */
+            END /** there are no more points */
+        };
+
+        /**
+         * @brief Construct a new Text Parser
+         *
+         * @param begin first character of the text
+         * @param end one past the last character of the text
+         */
+        TextParser(const char* begin, const char* end);
+
+        /**
+         * @brief read the next row
+         *
+         * @param point set to the point read, if the status is POINT
+         * @return Status what was read
+         */
+        Status next(TextPoint& point);
+
+        TextFormat format() const { return detected; }
+
+        /**
+         * @brief 1 based line number of the row last read
+         */
+        size_t line() const { return lineNumber; }
+    private:
+        const char* cursor;
+        const char* end;
+        TextFormat detected = TextFormat::LEMLIB_V05;
+        size_t lineNumber = 0;
+        bool started = false;
+        bool done = false;
+};
+} // namespace pathing
@@ -0,0 +1,76 @@
+#pragma once
+
+namespace pathing {
+/**
+ * @brief Limits of a one dimensional motion profile
+ */
+struct ProfileLimits {
+        float maxVelocity; /** inches per second */
+        float maxAcceleration; /** inches per second squared */
+        float maxJerk = 0; /** inches per second cubed. 0 for a trapezoidal profile */
+};
+
+/**
+ * @brief Where a motion profile wants the robot at one instant
+ */
+struct ProfileState {
+        float position; /** inches from the start */
+        float velocity; /** inches per second */
+        float acceleration; /** inches per second squared */
+};
+
+/**
+ * @brief Rest to rest velocity profile over a straight distance
+ *
+ * Trapezoidal when there is no jerk limit, otherwise an S-curve whose acceleration ramps up and down at the jerk
+ * limit. Moves too short to reach the velocity limit peak at a lower velocity instead. The profile is symmetric, so
+ * the deceleration half is the acceleration half played backwards.
+ *
+ * @b Example
+ * @code {.cpp}
+ * pathing::MotionProfile profile(48, {60, 120, 600});
+ * pathing::ProfileState target = profile.sample(0.5);
+ * @endcode
+ */
+class MotionProfile {
+    public:
+        /**
+         * @brief Construct an empty profile, already at its end
+         */
+        MotionProfile() = default;
+
+        /**
+         * @param distance length of the move, inches. Negative distances are profiled backwards
+         * @param limits the limits to respect. The acceleration and velocity limits must be positive
+         */
+        MotionProfile(float distance, const ProfileLimits& limits);
+
+        /**
+         * @brief the target at a time since the start, in seconds. Holds the end of the move after duration()
+         */
+        ProfileState sample(float t) const;
+
+        /**
+         * @brief how long the move takes, seconds
+         */
+        float duration() const { return 2 * rampTime + cruiseTime; }
+
+        float distance() const { return sign * length; }
+
+        /**
+         * @brief the fastest the profile goes, inches per second. Lower than the velocity limit on short moves
+         */
+        float peakVelocity() const { return peak; }
+    private:
+        ProfileState ramp(float t) const;
+
+        float sign = 1;
+        float length = 0;
+        float jerk = 0; /** 0 for a trapezoid */
+        float peak = 0; /** cruise velocity */
+        float peakAcceleration = 0;
+        float jerkTime = 0; /** time spent changing acceleration at each end of a ramp */
+        float rampTime = 0; /** time to reach the cruise velocity from rest */
+        float cruiseTime = 0;
+};
+} // namespace pathing
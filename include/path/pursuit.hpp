@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "path/view.hpp"
+
+namespace pathing {
+/**
+ * @brief Coarse spatial index of the segments in a path
+ *
+ * The path's bounding box is split into a fixed grid and every cell lists the segments that pass through it, so the
+ * point closest to an arbitrary position can be found without scanning the whole path. Storage is fixed size, if a
+ * path has too many segments to index the grid is marked as full and queries fall back to a linear scan.
+ */
+class SegmentGrid {
+    public:
+        static constexpr int CELLS = 16; /** cells along each axis */
+        static constexpr size_t CAPACITY = 2048; /** maximum number of cell entries */
+
+        /**
+         * @brief Construct an empty grid. Call build() before querying
+         */
+        SegmentGrid() = default;
+
+        /**
+         * @brief index the segments of a path
+         */
+        void build(const PathView& path);
+
+        /**
+         * @brief find the index of the path point closest to a position
+         */
+        size_t closest(const PathView& path, float x, float y) const;
+    private:
+        int cellIndex(float x, float y) const;
+
+        float minX = 0;
+        float minY = 0;
+        float cellWidth = 1;
+        float cellHeight = 1;
+        bool full = true;
+        std::array<uint16_t, CELLS * CELLS + 1> offsets {};
+        std::array<uint16_t, CAPACITY> segments {};
+};
+
+/**
+ * @brief How far ahead pure pursuit looks
+ *
+ * A long lookahead is smooth on straights but cuts the inside of tight arcs, a short one holds arcs but weaves at
+ * speed. The lookahead grows with the commanded speed from minLookahead up to maxLookahead, then shrinks for curvature
+ * in the path ahead. fixed() gives the same lookahead everywhere.
+ *
+ * @b Example
+ * @code {.cpp}
+ * pathing::LookaheadPolicy policy;
+ * policy.maxLookahead = 12;
+ * chassis.follow(redStakeRush, policy, 10000);
+ * @endcode
+ */
+struct LookaheadPolicy {
+        /** shortest lookahead, for tight arcs and slow sections. Inches, 4 by default */
+        float minLookahead = 4;
+        /** longest lookahead, for fast straights. Inches, 10 by default */
+        float maxLookahead = 10;
+        /** path speed at which the lookahead reaches maxLookahead, in motor power. 127 by default */
+        float fullSpeed = 127;
+        /** how much curvature shortens the lookahead: it is divided by 1 + curvatureGain * curvature, the curvature
+         * of the path it spans. Inches, 60 by default, which halves it on an arc of radius 60" */
+        float curvatureGain = 60;
+
+        /**
+         * @brief the same lookahead everywhere, how LemLib follows paths
+         */
+        static LookaheadPolicy fixed(float lookahead) { return {lookahead, lookahead, 1, 0}; }
+
+        /**
+         * @brief whether the lookahead ever changes
+         */
+        bool adaptive() const { return minLookahead != maxLookahead; }
+
+        /**
+         * @brief the lookahead for a commanded speed, before curvature shortens it
+         *
+         * @param speed commanded speed, in motor power. The sign is ignored
+         */
+        float speedLookahead(float speed) const;
+
+        /**
+         * @brief the lookahead for a commanded speed and the curvature of the path ahead
+         *
+         * @param speed commanded speed, in motor power. The sign is ignored
+         * @param curvature curvature of the next speedLookahead(speed) inches of path, from
+         * PathCursor::curvatureAhead(). 1 / inches, the sign is ignored
+         */
+        float lookahead(float speed, float curvature) const;
+};
+
+/**
+ * @brief Monotonic search state for pure pursuit
+ *
+ * Instead of rescanning the whole path every control tick, the cursor only looks a bounded window of points ahead of
+ * where the robot was last tick, and never moves backwards. If the robot ends up far from every point in the window
+ * (after a large pose correction for example) the segment grid is used to find where it is on the path again.
+ *
+ * @b Example
+ * @code {.cpp}
+ * pathing::PathCursor cursor(path);
+ * while (true) {
+ *     const size_t closest = cursor.update(pose.x, pose.y);
+ *     const pathing::Point target = cursor.lookahead(pose.x, pose.y, 8);
+ *     // ...
+ * }
+ * @endcode
+ */
+class PathCursor {
+    public:
+        /**
+         * @brief Construct a new Path Cursor
+         *
+         * @param path the path to track
+         * @param window how many points past the current one are searched each update
+         * @param recoveryDistance if the closest point in the window is further than this, the whole path is searched
+         * with the segment grid. Units in inches
+         */
+        PathCursor(PathView path, size_t window = 16, float recoveryDistance = 12);
+
+        /**
+         * @brief update the closest point for a new robot position
+         *
+         * @return index of the closest point
+         */
+        size_t update(float x, float y);
+
+        /**
+         * @brief index of the closest point found by the last update
+         */
+        size_t closest() const { return index; }
+
+        /**
+         * @brief find the lookahead point
+         *
+         * Only segments after the closest point and the previous lookahead point are considered, and the search stops
+         * once the path is too far along to intersect the lookahead circle. If there is no intersection, the previous
+         * lookahead point is returned.
+         *
+         * @param x robot x position
+         * @param y robot y position
+         * @param lookaheadDist radius of the lookahead circle
+         * @return the lookahead point. Its speed is the speed of the point at the start of its segment
+         */
+        Point lookahead(float x, float y, float lookaheadDist);
+
+        /**
+         * @brief the curvature of the next stretch of path after the closest point
+         *
+         * Curvature is that of the circle through the closest point and the points distance / 2 and distance further
+         * along the path, so it is the bend the lookahead circle spans rather than the sharpest kink between
+         * neighbouring points, which resampling and hand placed points make noisy.
+         *
+         * @param distance how much of the path to look at, inches
+         * @return 1 / inches, always positive. 0 on a straight
+         */
+        float curvatureAhead(float distance) const;
+    private:
+        PathView path;
+        size_t window;
+        float recoveryDistance;
+        size_t index = 0;
+        size_t lookaheadIndex = 0;
+        Point lastLookahead;
+        SegmentGrid grid;
+};
+
+/**
+ * @brief find where a circle intersects a segment
+ *
+ * @return the fraction along the segment of the intersection furthest along it, or -1 if there is none
+ */
+float circleIntersect(const Point& p1, const Point& p2, float x, float y, float radius);
+
+/**
+ * @brief curvature of the circle through three points
+ *
+ * @return 1 / inches, always positive. 0 if the points are in a line or two of them are the same
+ */
+float threePointCurvature(const Point& a, const Point& b, const Point& c);
+} // namespace pathing
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "path/trajectory.hpp"
+
+namespace pathing {
+/**
+ * @brief Gains of the RAMSETE controller
+ *
+ * b is per square inch. The b = 2 usually quoted is per square meter, about 0.0013 per square inch, which lets a robot
+ * this size drift a couple of inches before it reacts. The default is tuned with tools/bench/ramsete.cpp.
+ */
+struct RamseteGains {
+        float b = 0.04; /** how hard position error is corrected, like a proportional gain. Greater than 0 */
+        float zeta = 0.7; /** damping, between 0 and 1 */
+};
+
+/**
+ * @brief Velocity and turn rate for the robot's center
+ */
+struct ChassisSpeeds {
+        float velocity; /** inches per second, positive forwards */
+        float angular; /** radians per second, positive clockwise */
+};
+
+/**
+ * @brief the RAMSETE control law: the speeds that bring the robot back onto a trajectory
+ *
+ * Starts from the target sample's velocity and turn rate and corrects them for the robot's position and heading
+ * error in its own frame, which converges from any error as long as the target keeps moving.
+ *
+ * @param target the sample the robot should be at now
+ * @param x robot x, inches
+ * @param y robot y, inches
+ * @param heading robot heading in radians, 0 is +y and angles increase clockwise
+ * @param gains the controller gains
+ */
+ChassisSpeeds ramsete(const TrajectorySample& target, float x, float y, float heading, const RamseteGains& gains);
+
+/**
+ * @brief Speeds or accelerations of the two sides of the drivetrain
+ */
+struct WheelSpeeds {
+        float left; /** inches per second, or per second squared */
+        float right;
+};
+
+/**
+ * @brief the planned acceleration of each side of the drivetrain at a sample
+ *
+ * Taken from the change in each side's planned speed to the next sample, so a tightening turn speeds up the outside
+ * wheel even while the robot's center holds its speed. The acceleration and curvature of a sample alone miss that.
+ *
+ * @param trajectory the trajectory
+ * @param index the sample
+ * @param trackWidth inches
+ */
+WheelSpeeds wheelAccelerations(const TrajectoryView& trajectory, size_t index, float trackWidth);
+} // namespace pathing
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include "path/trajectory.hpp"
+#include "path/view.hpp"
+
+namespace pathing {
+class PathRegistry;
+
+/**
+ * @brief Stable reference to a path or trajectory loaded by a PathRegistry
+ *
+ * Handles are small and copyable, and stay valid as long as the registry does, even if more assets are added.
+ */
+struct PathHandle {
+        const PathRegistry* registry = nullptr;
+        uint16_t index = 0;
+
+        bool valid() const { return registry != nullptr; }
+};
+
+/**
+ * @brief Loads every path asset once, so starting a motion on one doesn't parse, decode or checksum anything
+ *
+ * Assets are added with add(), then load() validates all of them. Compressed paths are decoded and text paths are
+ * parsed into one arena, allocated once for every asset added so far. Uncompressed paths and trajectories are
+ * already in their final layout and are viewed in place.
+ *
+ * Call load() before any motion starts, usually in initialize(). Loading again after adding more assets moves the
+ * arena, which would pull the points out from under a path being followed.
+ *
+ * @b Example
+ * @code {.cpp}
+ * PATH_ASSET(RedStakeRush)
+ * pathing::PathRegistry registry;
+ * pathing::PathHandle rush = registry.add("RedStakeRush", RedStakeRush_path);
+ * registry.load(pros::micros);
+ * chassis.follow(rush, 10, 10000);
+ * @endcode
+ */
+class PathRegistry {
+    public:
+        enum class Kind { PATH, TRAJECTORY };
+
+        struct Entry {
+                const char* name;
+                asset source;
+                Kind kind = Kind::PATH;
+                LoadResult result = LoadResult::OK;
+                bool loaded = false;
+                size_t count = 0; /** number of points */
+                size_t stride = sizeof(Point); /** bytes from one point to the next */
+                TrajectoryView trajectory;
+                size_t offset = 0; /** where the points are in the arena, if they had to be decoded or parsed */
+                size_t arenaBytes = 0; /** bytes of the arena used, 0 if the asset is viewed in place */
+                uint32_t loadMicros = 0; /** time taken to load, if load() was given a clock */
+        };
+
+        /**
+         * @brief add an asset to be loaded
+         *
+         * @param name name used when reporting the asset
+         * @param source a binary path, compressed path, trajectory or LemLib/path.jerryio text path asset
+         * @return handle to the asset, usable once load() has been called
+         */
+        PathHandle add(const char* name, const asset& source);
+
+        /**
+         * @brief load every asset added since the last call
+         *
+         * @param micros clock used to time each asset, e.g. pros::micros. Nothing is timed if null
+         * @return the number of assets that failed to load
+         */
+        size_t load(uint64_t (*micros)() = nullptr);
+
+        const Entry& entry(PathHandle handle) const { return entries[handle.index]; }
+
+        size_t size() const { return entries.size(); }
+
+        /**
+         * @brief total bytes of the arena, the only memory the registry allocates for points
+         */
+        size_t arenaSize() const { return arena.size(); }
+
+        /**
+         * @brief view of a loaded path. Empty if it isn't a loaded path
+         */
+        PathView path(PathHandle handle) const;
+
+        /**
+         * @brief view of a loaded trajectory. Empty if it isn't a loaded trajectory
+         */
+        TrajectoryView trajectory(PathHandle handle) const;
+    private:
+        std::vector<Entry> entries;
+        std::vector<uint8_t> arena;
+};
+} // namespace pathing
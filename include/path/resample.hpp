@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include "path/format.hpp"
+
+namespace pathing {
+/**
+ * @brief Settings for resample()
+ */
+struct ResampleSettings {
+        float tolerance = 0.25; /** largest distance between the resampled path and the original curve, inches */
+        float speedTolerance = 2; /** largest difference between the original and resampled speed profiles */
+        /** longest segment allowed, inches. Pure pursuit cuts the corner of any segment longer than its lookahead, so
+         * this stays under the smallest lookahead in use, LookaheadPolicy's 4" minLookahead */
+        float maxSpacing = 3;
+        float sampleSpacing = 0.25; /** spacing of the dense curve the points are picked from, inches */
+};
+
+/**
+ * @brief Resample a path so points are placed by curvature instead of at a fixed spacing
+ *
+ * A centripetal Catmull-Rom spline through the original points is sampled densely, then points are picked greedily:
+ * each segment is made as long as possible while the curve stays within the tolerance of it and the speed, taken as
+ * linear between points, stays within the speed tolerance. Straight runs collapse to a few points and tight turns get
+ * as many as they need, possibly more than the original. The first and last points, points with a heading, and the
+ * point where the speed drops to 0 are always kept.
+ *
+ * @param points the original points
+ * @param headings heading of each original point, or empty
+ * @param settings the tolerances
+ * @param outPoints set to the resampled points
+ * @param outHeadings set to the headings of the resampled points, empty if headings is empty
+ *
+ * @b Example
+ * @code {.cpp}
+ * std::vector<pathing::Point> points, resampled;
+ * std::vector<float> headings;
+ * pathing::resample(points, {}, {}, resampled, headings);
+ * @endcode
+ */
+void resample(const std::vector<Point>& points, const std::vector<float>& headings, const ResampleSettings& settings,
+              std::vector<Point>& outPoints, std::vector<float>& outHeadings);
+} // namespace pathing
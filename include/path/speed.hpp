@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cmath>
+#include "path/view.hpp"
+
+namespace pathing {
+/**
+ * @brief Physical speed limits for following a path
+ *
+ * The speed column of a path is whatever the path was drawn with. These limits cap it where the robot can't go that
+ * fast: through turns, where the sideways acceleration would make the wheels slide, and before slow points and the
+ * end of the path, where the robot couldn't stop in time.
+ */
+struct SpeedLimits {
+        /** sideways acceleration the wheels hold without sliding, inches per second squared. INFINITY for no limit */
+        float maxLateralAcceleration = INFINITY;
+        /** how hard the robot brakes, inches per second squared. INFINITY for no limit */
+        float maxDeceleration = INFINITY;
+
+        /**
+         * @brief whether either limit is set
+         */
+        bool enabled() const { return std::isfinite(maxLateralAcceleration) || std::isfinite(maxDeceleration); }
+
+        /**
+         * @brief the highest speed on an arc that keeps under maxLateralAcceleration
+         *
+         * @param curvature of the arc, 1 / inches. The sign is ignored
+         * @param fullSpeed inches per second at a speed of 127
+         * @return the speed in motor power, INFINITY on a straight or with no limit
+         */
+        float turnSpeed(float curvature, float fullSpeed) const {
+            if (curvature == 0 || !std::isfinite(maxLateralAcceleration)) return INFINITY;
+            return std::sqrt(maxLateralAcceleration / std::fabs(curvature)) * 127 / fullSpeed;
+        }
+};
+
+/**
+ * @brief cap the speed of every point of a path by the physical limits
+ *
+ * A point's cap is sqrt(maxLateralAcceleration / curvature), with the curvature of the circle through it and its
+ * neighbours. A backward pass from the end then lowers each point so the robot can brake to the next one at
+ * maxDeceleration. The result is the lowest of the file speed and both limits, so the limits never speed a path up.
+ * The last point stays at 0, and no other point can reach 0 unless its file speed is 0.
+ *
+ * @param path the path
+ * @param limits the limits
+ * @param fullSpeed inches per second at a speed of 127, to convert between path speed and the limits
+ * @param speeds set to the capped speed of each point, in the same units as the path. Must hold path.size() floats
+ *
+ * @b Example
+ * @code {.cpp}
+ * std::vector<float> speeds(path.size());
+ * pathing::limitSpeeds(path, {120, 200}, 57.4, speeds.data());
+ * @endcode
+ */
+void limitSpeeds(const PathView& path, const SpeedLimits& limits, float fullSpeed, float* speeds);
+} // namespace pathing
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "path/format.hpp"
+#include "path/transform.hpp"
+
+/**
+ * Time parameterized trajectories
+ *
+ * tools/trajc.cpp reads the Bezier control points JerryIO stores in the trailer of each path file and generates a
+ * trajectory sampled at a fixed time step, under the drivetrain's limits. The asset uses the same 16 byte header as
+ * binary paths (see include/path/format.hpp) with its own magic:
+ *
+ *   offset  size  field
+ *   0       16    header, magic "LTRJ"
+ *   16      4     float32 time step, seconds
+ *   20      ...   count * TrajectorySample
+ *
+ * The checksum covers everything after the header.
+ */
+namespace pathing {
+
+constexpr uint8_t TRAJECTORY_MAGIC[4] = {'L', 'T', 'R', 'J'};
+constexpr uint16_t TRAJECTORY_VERSION = 1;
+
+/**
+ * @brief The state of the robot at one instant of a trajectory
+ */
+struct TrajectorySample {
+        float x; /** inches */
+        float y; /** inches */
+        float heading; /** degrees, 0 is +y and angles increase clockwise */
+        float velocity; /** inches per second */
+        float acceleration; /** inches per second squared */
+        float curvature; /** 1 / inches, positive when turning clockwise */
+};
+
+static_assert(sizeof(TrajectorySample) == 24, "trajectory samples must be packed floats");
+
+/**
+ * @brief A 2D position, used for Bezier control points
+ */
+struct Vec2 {
+        float x;
+        float y;
+};
+
+/**
+ * @brief A cubic Bezier segment. Straight segments have their controls on the line between the end points
+ */
+using Cubic = std::array<Vec2, 4>;
+
+/**
+ * @brief Limits the trajectory generator has to respect
+ */
+struct TrajectoryLimits {
+        float maxVelocity; /** top wheel speed, inches per second */
+        float maxAcceleration; /** inches per second squared */
+        float trackWidth; /** inches */
+        float speedLimit = 1; /** fraction of maxVelocity the path may use */
+        float decelerationRate = INFINITY; /** largest drop in speed per inch travelled, inches per second per inch */
+};
+
+/**
+ * @brief generate a time parameterized trajectory along a chain of Bezier segments
+ *
+ * The curve is sampled densely, every point gets a speed cap from the path speed limit and from keeping the outside
+ * wheel under the top speed, and forward and backward passes apply the acceleration limits. The trajectory starts and
+ * ends at rest.
+ *
+ * @param segments the segments, in order. Each segment should start where the previous one ended
+ * @param limits the limits to respect
+ * @param dt time between samples, seconds
+ * @return the samples, or nothing if the segments have no length
+ */
+std::vector<TrajectorySample> generateTrajectory(const std::vector<Cubic>& segments, const TrajectoryLimits& limits,
+                                                 float dt);
+
+/**
+ * @brief encode a trajectory into the binary trajectory format
+ */
+std::vector<uint8_t> encodeTrajectory(const std::vector<TrajectorySample>& samples, float dt);
+
+/**
+ * @brief check whether an asset starts with the trajectory magic
+ */
+bool isTrajectory(const asset& trajectory);
+
+/**
+ * @brief Non-owning view of the samples in a trajectory, read in place like PathView
+ */
+class TrajectoryView {
+    public:
+        /**
+         * @brief Construct an empty view
+         */
+        TrajectoryView() = default;
+        /**
+         * @brief Construct a view over packed samples
+         *
+         * @param data pointer to the first sample. No alignment is required
+         * @param count number of samples
+         * @param dt time between samples, seconds
+         */
+        TrajectoryView(const uint8_t* data, size_t count, float dt)
+            : data(data),
+              count(count),
+              dt(dt) {}
+
+        /**
+         * @brief Create a view over a trajectory asset
+         *
+         * @param trajectory the asset to view
+         * @param result if not null, set to the result of validating the asset
+         * @return the view, or an empty view if the asset is not a valid trajectory
+         *
+         * @b Example
+         * @code {.cpp}
+         * TRAJECTORY_ASSET(RedRing1)
+         * pathing::TrajectoryView trajectory = pathing::TrajectoryView::fromAsset(RedRing1_traj);
+         * @endcode
+         */
+        static TrajectoryView fromAsset(const asset& trajectory, LoadResult* result = nullptr);
+
+        size_t size() const { return count; }
+
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief time between samples, seconds
+         */
+        float timeStep() const { return dt; }
+
+        /**
+         * @brief time from the first sample to the last, seconds
+         */
+        float duration() const { return count == 0 ? 0 : (count - 1) * dt; }
+
+        /**
+         * @brief index of the sample at a time since the start, clamped to the trajectory
+         */
+        size_t indexAt(float t) const {
+            if (t <= 0 || count == 0) return 0;
+            const size_t i = size_t(t / dt);
+            return i < count ? i : count - 1;
+        }
+
+        /**
+         * @brief get a sample. The index is not bounds checked
+         */
+        TrajectorySample operator[](size_t i) const {
+            TrajectorySample sample;
+            std::memcpy(&sample, data + i * sizeof(TrajectorySample), sizeof(TrajectorySample));
+            if (transform != FieldTransform::NONE) {
+                sample.x = transformX(transform, sample.x);
+                sample.y = transformY(transform, sample.y);
+                sample.heading = transformHeading(transform, sample.heading);
+                if (mirrorsHandedness(transform)) sample.curvature = -sample.curvature;
+            }
+            return sample;
+        }
+
+        TrajectorySample front() const { return (*this)[0]; }
+
+        TrajectorySample back() const { return (*this)[count - 1]; }
+
+        /**
+         * @brief get a view of the same samples with a field transform applied
+         */
+        TrajectoryView transformed(FieldTransform other) const {
+            TrajectoryView view = *this;
+            view.transform = compose(transform, other);
+            return view;
+        }
+    private:
+        const uint8_t* data = nullptr;
+        size_t count = 0;
+        float dt = 0;
+        FieldTransform transform = FieldTransform::NONE;
+};
+} // namespace pathing
+
+/**
+ * @brief declare a compiled trajectory asset
+ *
+ * The trajectory generated from static/<name>.txt is declared as <name>_traj. Only the paths named in TRAJ_PATHS
+ * (see firmware/trajectory-asset.mk) have one linked, others fail to link
+ *
+ * @b Example
+ * @code {.cpp}
+ * TRAJECTORY_ASSET(RedRing1)
+ * chassis.follow(RedRing1_traj, 8, 2500);
+ * @endcode
+ */
+#define TRAJECTORY_ASSET(x)                                                                                            \
+    extern "C" {                                                                                                       \
+    extern uint8_t _binary_paths_##x##_traj_start[], _binary_paths_##x##_traj_size[];                                  \
+    static asset x##_traj = {_binary_paths_##x##_traj_start, (size_t)_binary_paths_##x##_traj_size};                   \
+    }
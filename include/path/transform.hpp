@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cmath>
+
+namespace pathing {
+/**
+ * @brief Symmetries of the field, used to run a routine written for one alliance on the other
+ *
+ * Headings follow the LemLib convention, 0 is +y and angles increase clockwise.
+ */
+enum class FieldTransform {
+    NONE = 0, /** leave coordinates unchanged */
+    FLIP_X = 1, /** negate x, mirroring across the y axis. Red and blue routines are related by this */
+    FLIP_Y = 2, /** negate y, mirroring across the x axis */
+    ROTATE_180 = 3 /** negate both x and y, rotating half a turn about the field center */
+};
+
+/**
+ * @brief the transform equivalent to applying a and then b
+ */
+constexpr FieldTransform compose(FieldTransform a, FieldTransform b) {
+    // each bit flips one axis, so composing is xor
+    return FieldTransform(int(a) ^ int(b));
+}
+
+constexpr float transformX(FieldTransform transform, float x) {
+    return transform == FieldTransform::FLIP_X || transform == FieldTransform::ROTATE_180 ? -x : x;
+}
+
+constexpr float transformY(FieldTransform transform, float y) {
+    return transform == FieldTransform::FLIP_Y || transform == FieldTransform::ROTATE_180 ? -y : y;
+}
+
+/**
+ * @brief transform a heading
+ *
+ * @param transform the transform to apply
+ * @param theta the heading
+ * @param radians whether theta is in radians. false by default
+ * @return the transformed heading, in [0, 360) degrees or [0, 2pi) radians
+ */
+inline float transformHeading(FieldTransform transform, float theta, bool radians = false) {
+    const float half = radians ? M_PI : 180;
+    switch (transform) {
+        case FieldTransform::NONE: return theta;
+        case FieldTransform::FLIP_X: theta = -theta; break;
+        case FieldTransform::FLIP_Y: theta = half - theta; break;
+        case FieldTransform::ROTATE_180: theta = theta + half; break;
+    }
+    theta = std::fmod(theta, 2 * half);
+    return theta < 0 ? theta + 2 * half : theta;
+}
+
+/**
+ * @brief whether the transform swaps left and right, and so clockwise and counterclockwise
+ */
+constexpr bool mirrorsHandedness(FieldTransform transform) {
+    return transform == FieldTransform::FLIP_X || transform == FieldTransform::FLIP_Y;
+}
+} // namespace pathing
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include "path/format.hpp"
+#include "path/transform.hpp"
+
+namespace pathing {
+/**
+ * @brief Non-owning, random access view of the points in a path
+ *
+ * Points are read in place from wherever the path is stored (usually the asset buffer the linker placed in memory),
+ * so creating and copying a view never allocates.
+ *
+ * Views can be reversed, sliced, concatenated, offset and field transformed. The result is another view over the same
+ * storage, made of up to MAX_PIECES runs of stored points, so routes can be assembled from shared segments without
+ * copying any points. The last point of a view always reads with speed 0, since that is what ends a motion.
+ */
+class PathView {
+    public:
+        /** most runs of stored points a view can be made of */
+        static constexpr size_t MAX_PIECES = 8;
+
+        /**
+         * @brief Construct an empty view
+         */
+        PathView() = default;
+        /**
+         * @brief Construct a view over packed point data
+         *
+         * @param data pointer to the first point. No alignment is required
+         * @param count number of points
+         * @param stride bytes from the start of one point to the next
+         */
+        PathView(const uint8_t* data, size_t count, size_t stride = sizeof(Point))
+            : pieceCount(count > 0 ? 1 : 0),
+              count(count) {
+            pieces[0].data = data;
+            pieces[0].count = count;
+            pieces[0].stride = stride;
+        }
+
+        /**
+         * @brief Create a view over a binary path asset
+         *
+         * @param path the asset to view
+         * @param result if not null, set to the result of validating the asset
+         * @return the view, or an empty view if the asset is not a valid binary path. Compressed paths can't be
+         * viewed in place, see decode()
+         *
+         * @b Example
+         * @code {.cpp}
+         * PATH_ASSET(RedRing1)
+         * pathing::PathView path = pathing::PathView::fromAsset(RedRing1_path);
+         * @endcode
+         */
+        static PathView fromAsset(const asset& path, LoadResult* result = nullptr);
+
+        size_t size() const { return count; }
+
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief get a point. The index is not bounds checked
+         */
+        Point operator[](size_t i) const {
+            const bool last = i + 1 == count;
+            const Piece* piece = pieces;
+            while (i >= piece->count) i -= piece->count, piece++;
+            Point point = piece->point(i);
+            if (last) point.speed = 0;
+            return point;
+        }
+
+        /**
+         * @brief whether any point in the view can have a heading
+         */
+        bool hasHeading() const {
+            for (size_t p = 0; p < pieceCount; p++) {
+                if (pieces[p].stride > sizeof(Point)) return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief get the heading of a point in degrees
+         *
+         * @return the heading, or NaN if the point has none
+         */
+        float heading(size_t i) const {
+            const Piece* piece = pieces;
+            while (i >= piece->count) i -= piece->count, piece++;
+            return piece->heading(i);
+        }
+
+        Point front() const { return (*this)[0]; }
+
+        Point back() const { return (*this)[count - 1]; }
+
+        /**
+         * @brief get a view of the same points with a field transform applied
+         *
+         * The transform is applied as points are read, the path data is not copied or parsed again.
+         *
+         * @b Example
+         * @code {.cpp}
+         * // the red ring side path, driven on the blue side
+         * pathing::PathView blue = red.transformed(pathing::FieldTransform::FLIP_X);
+         * @endcode
+         */
+        PathView transformed(FieldTransform other) const;
+
+        /**
+         * @brief get a view of the points in reverse order
+         *
+         * Points past the first one with speed 0 are dropped first, since they only extend the path beyond its end.
+         * The new first point reads the speed the original reached it at, every other point keeps its own. Headings
+         * are unchanged, so the robot faces the same way at each point when it drives back with forwards = false.
+         *
+         * @b Example
+         * @code {.cpp}
+         * // drive the rush path back to where it started
+         * chassis.follow(rush.reversed(), 10, 10000, false);
+         * @endcode
+         */
+        PathView reversed() const;
+
+        /**
+         * @brief get a view of the points from begin up to but not including end
+         *
+         * @return the view, empty if the range is empty. The range is clamped to the view
+         */
+        PathView slice(size_t begin, size_t end) const;
+
+        /**
+         * @brief get a view of this path followed by another
+         *
+         * This path is cut at its first point with speed 0, so the robot carries on into the next path instead of
+         * stopping.
+         *
+         * @return the view, or an empty view if the two together are made of more than MAX_PIECES runs
+         *
+         * @b Example
+         * @code {.cpp}
+         * pathing::PathView route = first.concatenated(second).concatenated(third);
+         * @endcode
+         */
+        PathView concatenated(const PathView& next) const;
+
+        /**
+         * @brief get a view of the path rotated about its first point and then moved
+         *
+         * @param dx distance to move the path along x, inches
+         * @param dy distance to move the path along y, inches
+         * @param degrees clockwise rotation about the first point, so headings increase by this much
+         *
+         * @b Example
+         * @code {.cpp}
+         * // the same approach, started 24 inches further up the field and turned a quarter turn
+         * pathing::PathView moved = approach.offset(0, 24, 90);
+         * @endcode
+         */
+        PathView offset(float dx, float dy, float degrees = 0) const;
+    private:
+        // a run of stored points, read in either direction, field transformed and then rotated and moved
+        struct Piece {
+                const uint8_t* data = nullptr;
+                size_t count = 0;
+                size_t stride = sizeof(Point);
+                bool reversed = false;
+                FieldTransform transform = FieldTransform::NONE;
+                bool moved = false; /** whether the rotation and offset below are used */
+                float degrees = 0; /** clockwise rotation */
+                float cos = 1;
+                float sin = 0;
+                float dx = 0;
+                float dy = 0;
+                // speeds read in place of the stored ones at the first and last stored point, NaN if not replaced.
+                // Kept by stored index so they stay on the same point when the piece is sliced or reversed again
+                float firstSpeed = NAN;
+                float lastSpeed = NAN;
+
+                Point point(size_t i) const {
+                    const size_t j = reversed ? count - 1 - i : i;
+                    Point point;
+                    std::memcpy(&point, data + j * stride, sizeof(Point));
+                    if (j == 0 && !std::isnan(firstSpeed)) point.speed = firstSpeed;
+                    else if (j == count - 1 && !std::isnan(lastSpeed)) point.speed = lastSpeed;
+                    point.x = transformX(transform, point.x);
+                    point.y = transformY(transform, point.y);
+                    if (moved) {
+                        const float x = point.x;
+                        point.x = x * cos + point.y * sin + dx;
+                        point.y = point.y * cos - x * sin + dy;
+                    }
+                    return point;
+                }
+
+                float heading(size_t i) const {
+                    if (stride <= sizeof(Point)) return NAN;
+                    float theta;
+                    std::memcpy(&theta, data + (reversed ? count - 1 - i : i) * stride + sizeof(Point), sizeof(float));
+                    if (std::isnan(theta)) return theta;
+                    theta = transformHeading(transform, theta) + degrees;
+                    theta = std::fmod(theta, 360.0f);
+                    return theta < 0 ? theta + 360 : theta;
+                }
+        };
+
+        // index of the first stored point after the start with speed 0, or size() if there is none
+        size_t firstStop() const;
+
+        Piece pieces[MAX_PIECES];
+        size_t pieceCount = 0;
+        size_t count = 0;
+};
+
+/**
+ * @brief size of the buffer needed to decode a binary path, in bytes. 0 if the asset is not a binary path
+ */
+size_t decodedSize(const asset& path);
+
+/**
+ * @brief decode a binary path into a caller provided buffer
+ *
+ * Compressed point data is expanded in a single pass, uncompressed point data is copied. Either way the buffer ends up
+ * holding uncompressed points, which the returned view reads in place.
+ *
+ * @param path the asset to decode
+ * @param out the buffer to decode into
+ * @param capacity size of the buffer in bytes, at least decodedSize(path)
+ * @param result if not null, set to the result of decoding the asset
+ * @return a view of the decoded points, or an empty view if the asset could not be decoded
+ *
+ * @b Example
+ * @code {.cpp}
+ * PATH_ASSET(RedRing1)
+ * static uint8_t buffer[1024];
+ * pathing::PathView path = pathing::decode(RedRing1_path, buffer, sizeof(buffer));
+ * @endcode
+ */
+PathView decode(const asset& path, uint8_t* out, size_t capacity, LoadResult* result = nullptr);
+} // namespace pathing
@@ -2,6 +2,7 @@
 #include "config.hpp"
 #include "auto.h"
 #include "lemlib/timer.hpp"
+#include "path/registry.hpp"
 
 enum class AutonomousMode {
     SKILLS,
@@ -10,12 +11,16 @@ enum class AutonomousMode {
     BLUE_RING,
     BLUE_STAKE,      
     TEST,
-    LIAM_SKILLS
+    LIAM_SKILLS,
+    CHARACTERIZE
 };
   
 // Current autonomous selection
 static AutonomousMode current_auto = AutonomousMode::LIAM_SKILLS;
 
+// Every path the routines follow. Handles are added next to their assets and loaded once by load_paths()
+static pathing::PathRegistry paths;
+
 namespace autosetting {
     struct IntakeState {
         // Ring Eject States
@@ -165,10 +170,20 @@ namespace autosetting {
         return LBState::isRunning;
     }
 
+    // close the clamp once the next motion has traveled distance inches. Runs from the motion task, so the routine
+    // doesn't have to waitUntil() and poll
+    void clamp_at(float distance) {
+        robot::drivetrain::chassis.addMarker(
+            motion::Marker::atDistance(distance, []() { robot::mechanisms::clamp.set_value(true); }));
+    }
+
     void pickup_ring(float x, float y, float exitRange1, float exitRange2) {
-        robot::drivetrain::chassis.moveToPoint(x, y, 1000, {.minSpeed = 127, .earlyExitRange = exitRange1});
-        robot::drivetrain::chassis.moveToPoint(x, y, 1000, {.maxSpeed = 70, .earlyExitRange = exitRange2});
-        robot::drivetrain::chassis.moveToPoint(x, y, 1000, {.maxSpeed = 120});
+        // full speed until exitRange1 from the ring, 70 through the ring, then settle. Queued so the robot carries
+        // its speed between the three instead of stopping and starting again
+        robot::drivetrain::chassis.queueMoveToPoint(x, y, 1000, {.blendRadius = exitRange1});
+        robot::drivetrain::chassis.queueMoveToPoint(x, y, 1000, {.maxSpeed = 70, .blendRadius = exitRange2});
+        robot::drivetrain::chassis.queueMoveToPoint(x, y, 1000, {.maxSpeed = 120});
+        robot::drivetrain::chassis.runQueue();
     }
 }
 
@@ -177,8 +192,10 @@ namespace autosetting {
      270     90
          180
 */
-ASSET(Skill1_txt)
-ASSET(Skill2_txt)
+PATH_ASSET(Skill1)
+PATH_ASSET(Skill2)
+static const pathing::PathHandle skill1 = paths.add("Skill1", Skill1_path);
+static const pathing::PathHandle skill2 = paths.add("Skill2", Skill2_path);
 
 void skills_auto() {
     // Q1
@@ -239,22 +256,18 @@ void skills_auto() {
         autosetting::run_LB(25000);
         pros::delay(600);
 
-        robot::drivetrain::chassis.moveToPoint(-47, 0, 1000, {.forwards = false});
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.moveToPoint(-47, 0, 1000, {.forwards = false}).waitUntilDone();
         autosetting::run_LB(0);
 
 
         robot::drivetrain::chassis.turnToHeading(180, 1000);
-        robot::drivetrain::chassis.moveToPoint(-47, 26.03, 1000, {.forwards = false, .maxSpeed = 60});
-        robot::drivetrain::chassis.waitUntil(21); // 11 
-        robot::mechanisms::clamp.set_value(true);
-        robot::drivetrain::chassis.waitUntilDone();
+        autosetting::clamp_at(21);
+        robot::drivetrain::chassis.moveToPoint(-47, 26.03, 1000, {.forwards = false, .maxSpeed = 60}).waitUntilDone();
         robot::mechanisms::lbMotor.set_brake_mode(pros::E_MOTOR_BRAKE_COAST);
         robot::mechanisms::lbMotor.move_velocity(0);
 
         // Q1 ---
-        robot::drivetrain::chassis.turnToPoint(point1x, point1y, 1000); 
-        robot::drivetrain::chassis.waitUntilDone();  
+        robot::drivetrain::chassis.turnToPoint(point1x, point1y, 1000).waitUntilDone();
         autosetting::run_intake(20000);
         autosetting::pickup_ring(point1x, point1y, 9, 4); //1111111
 
@@ -319,53 +332,52 @@ void skills_auto() {
      270     90
          180
 */
-ASSET(RedRing1_txt);
+// followed as a path until TRAJ_ACCEL in firmware/trajectory-asset.mk is measured, the trajectory is planned on a
+// guessed acceleration limit
+PATH_ASSET(RedRing1);
+static const pathing::PathHandle redRing1 = paths.add("RedRing1", RedRing1_path);
 void red_ring_auto() {
     try {
         robot::mechanisms::lbRotationSensor.set_position(4800);
         robot::drivetrain::chassis.setPose(-54.383, 16.126, 180); 
-        robot::drivetrain::chassis.swingToHeading(236, lemlib::DriveSide::RIGHT, 800);
-        robot::drivetrain::chassis.waitUntil(50);
+        robot::drivetrain::chassis.swingToHeading(236, lemlib::DriveSide::RIGHT, 800).waitUntil(50);
         autosetting::run_LB(25000);
         pros::delay(600);
  
         
         robot::drivetrain::chassis.turnToPoint(-19.01, 24.865, 300, {.forwards = false});
 
-        robot::drivetrain::chassis.moveToPoint(-19.01, 24.865, 2000, {.forwards = false, .minSpeed = 127, .earlyExitRange = 35});
+        motion::MotionHandle stakeApproach = robot::drivetrain::chassis.moveToPoint(-19.01, 24.865, 2000, {.forwards = false, .minSpeed = 127, .earlyExitRange = 35});
         pros::delay(200);
         autosetting::run_LB(0);
 
-        robot::drivetrain::chassis.waitUntilDone();
+        stakeApproach.waitUntilDone();
         robot::mechanisms::lbMotor.set_brake_mode(pros::E_MOTOR_BRAKE_COAST);
         robot::mechanisms::lbMotor.move_velocity(0);
 
+        autosetting::clamp_at(30);
         robot::drivetrain::chassis.moveToPoint(-19.01, 24.865, 2000, {.forwards = false, .maxSpeed = 70});
-        robot::drivetrain::chassis.waitUntil(30);
-        robot::mechanisms::clamp.set_value(true);
         robot::mechanisms::lbRotationSensor.set_position(0);
         robot::drivetrain::chassis.turnToHeading(330, 600);
         autosetting::run_intake(7000);
-        robot::drivetrain::chassis.follow(RedRing1_txt, 8, 2500);
+        robot::drivetrain::chassis.follow(redRing1, 8, 2500);
         pros::delay(2000);
 
         robot::drivetrain::chassis.moveToPoint(-29.914, 48.946, 1000, {.forwards = false});
         robot::drivetrain::chassis.turnToPoint(-45.256, 14, 1000);
-        robot::drivetrain::chassis.moveToPoint(-45.256, 14, 2000, {.minSpeed = 127, .earlyExitRange = 30});
-        robot::drivetrain::chassis.moveToPoint(-45.256, 14, 2000, {.maxSpeed = 60});
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.queueMoveToPoint(-45.256, 14, 2000, {.blendRadius = 30});
+        robot::drivetrain::chassis.queueMoveToPoint(-45.256, 14, 2000, {.maxSpeed = 60});
+        robot::drivetrain::chassis.runQueue().waitUntilDone();
         robot::mechanisms::doinker.set_value(true);
         pros::delay(300);
-        robot::drivetrain::chassis.moveToPoint(-37.585, 31.468, 1000, {.forwards = false});
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.moveToPoint(-37.585, 31.468, 1000, {.forwards = false}).waitUntilDone();
         robot::mechanisms::doinker.set_value(false);
         autosetting::run_intake(4000);
         robot::drivetrain::chassis.turnToPoint(-41.178, 12.825, 1000);
         robot::drivetrain::chassis.moveToPoint(-41.178, 12.825, 1000);
         pros::delay(200);
         robot::drivetrain::chassis.turnToPoint(-35.546, 6.222, 800);
-        robot::drivetrain::chassis.moveToPoint(-35.546, 6.222, 1000);
-        robot::drivetrain::chassis.waitUntil(5);
+        robot::drivetrain::chassis.moveToPoint(-35.546, 6.222, 1000).waitUntil(5);
         robot::mechanisms::doinker.set_value(true);
 
         
@@ -380,47 +392,44 @@ void red_ring_auto() {
      270     90
          180
 */
-ASSET(RedStakeRush_txt)
-ASSET(RedStakeReturn_txt)
+PATH_ASSET(RedStakeRush)
+PATH_ASSET(RedStakeReturn)
+static const pathing::PathHandle redStakeRush = paths.add("RedStakeRush", RedStakeRush_path);
+static const pathing::PathHandle redStakeReturn = paths.add("RedStakeReturn", RedStakeReturn_path);
 void red_stake_auto() {
     try {
         robot::drivetrain::chassis.setPose(-52.053, -59.611, 90);
-        robot::drivetrain::chassis.follow(RedStakeRush_txt, 10, 10000);
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.follow(redStakeRush, pathing::LookaheadPolicy::fixed(10), 10000).waitUntilDone();
         robot::mechanisms::doinker.set_value(true);
         pros::delay(100);
-        robot::drivetrain::chassis.follow(RedStakeReturn_txt, 10, 10000, false);
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.follow(redStakeReturn, pathing::LookaheadPolicy::fixed(10), 10000, false)
+            .waitUntilDone();
         robot::mechanisms::doinker.set_value(false);
         robot::drivetrain::chassis.moveToPoint(-49.528, -60.194, 1000, {.forwards = false});
         robot::drivetrain::chassis.turnToHeading(270, 1000);
-        robot::drivetrain::chassis.moveToPoint(-19.74, -60.194, 1500, {.forwards = false, .maxSpeed = 70});
-        robot::drivetrain::chassis.waitUntil(25);
-        robot::mechanisms::clamp.set_value(true);
-        robot::drivetrain::chassis.waitUntilDone();
+        autosetting::clamp_at(25);
+        robot::drivetrain::chassis.moveToPoint(-19.74, -60.194, 1500, {.forwards = false, .maxSpeed = 70})
+            .waitUntilDone();
         autosetting::run_intake(2000);
         robot::drivetrain::chassis.moveToPoint(-50.499, -59.028, 1500);
-        robot::drivetrain::chassis.turnToPoint(-29.137, -50.095, 1000, {.direction = AngularDirection::CCW_COUNTERCLOCKWISE});
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.turnToPoint(-29.137, -50.095, 1000, {.direction = AngularDirection::CCW_COUNTERCLOCKWISE})
+            .waitUntilDone();
         robot::mechanisms::clamp.set_value(false);
         pros::delay(100);
 
         // Day 2 stuff (need tuning)
-        robot::drivetrain::chassis.moveToPoint(-25.253, -47.182, 1500, {.minSpeed = 127, .earlyExitRange = 20});
-        robot::drivetrain::chassis.waitUntilDone();
-        autosetting::run_intake(900);
-        robot::drivetrain::chassis.moveToPoint(-25.253, -47.182, 1500, {.maxSpeed = 70});
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.addMarker(motion::Marker::atIndex(1, []() { autosetting::run_intake(900); }));
+        robot::drivetrain::chassis.queueMoveToPoint(-25.253, -47.182, 1500, {.blendRadius = 20});
+        robot::drivetrain::chassis.queueMoveToPoint(-25.253, -47.182, 1500, {.maxSpeed = 70});
+        robot::drivetrain::chassis.runQueue().waitUntilDone();
         robot::drivetrain::chassis.turnToPoint(-22.923, -19.334, 1000, {.forwards = false});
-        robot::drivetrain::chassis.moveToPoint(-22.923, -19.334, 1500, {.forwards = false, .maxSpeed = 80});
-        robot::drivetrain::chassis.waitUntil(25);
-        robot::mechanisms::clamp.set_value(true);
-        robot::drivetrain::chassis.waitUntilDone();  
+        autosetting::clamp_at(25);
+        robot::drivetrain::chassis.moveToPoint(-22.923, -19.334, 1500, {.forwards = false, .maxSpeed = 80})
+            .waitUntilDone();
         autosetting::run_intake(3000);
         pros::delay(300);
         robot::drivetrain::chassis.turnToHeading(20, 1000);
-        robot::drivetrain::chassis.moveToPoint(-21.564, -12.809, 1500);
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.moveToPoint(-21.564, -12.809, 1500).waitUntilDone();
         robot::mechanisms::doinker.set_value(true);
     } catch (const std::exception& e) {
         pros::lcd::print(0, "Two Stake Red Auto Error: %s", e.what());
@@ -432,68 +441,19 @@ void red_stake_auto() {
          180
 */
 
-ASSET(BlueRing1_txt)
+// The blue ring side is the red routine mirrored across the field's y axis
 void blue_ring_auto() {
-    try {
-        
-        robot::mechanisms::lbRotationSensor.set_position(4800);
-        robot::drivetrain::chassis.setPose(54.383, 16.126, 180); //------------
-        robot::drivetrain::chassis.swingToHeading(124, lemlib::DriveSide::LEFT, 800);
-        robot::drivetrain::chassis.waitUntil(50);
-        autosetting::run_LB(25000);
-        pros::delay(600);
- 
-    
-        robot::drivetrain::chassis.turnToPoint(19.01, 24.865, 300, {.forwards = false});
-
-        robot::drivetrain::chassis.moveToPoint(19.01, 24.865, 2000, {.forwards = false, .minSpeed = 127, .earlyExitRange = 35});
-        pros::delay(200);
-        autosetting::run_LB(0);
-
-        robot::drivetrain::chassis.waitUntilDone();
-        robot::mechanisms::lbMotor.set_brake_mode(pros::E_MOTOR_BRAKE_COAST);
-        robot::mechanisms::lbMotor.move_velocity(0);
-
-        robot::drivetrain::chassis.moveToPoint(19.01, 24.865, 2000, {.forwards = false, .maxSpeed = 70});
-        robot::drivetrain::chassis.waitUntil(30);
-        robot::mechanisms::clamp.set_value(true);
-        robot::mechanisms::lbRotationSensor.set_position(0);
-        robot::drivetrain::chassis.turnToHeading(30, 600);
-        autosetting::run_intake(7000);
-        robot::drivetrain::chassis.follow(BlueRing1_txt, 8, 2500);
-        pros::delay(2000);
-
-        robot::drivetrain::chassis.moveToPoint(29.914, 48.946, 1000, {.forwards = false});
-        robot::drivetrain::chassis.turnToPoint(45.256, 14, 1000);
-        robot::drivetrain::chassis.moveToPoint(45.256, 14, 2000, {.minSpeed = 127, .earlyExitRange = 30});
-        robot::drivetrain::chassis.moveToPoint(45.256, 14, 2000, {.maxSpeed = 60});
-        robot::drivetrain::chassis.waitUntilDone();
-        robot::mechanisms::doinker.set_value(true);
-        pros::delay(300);
-        robot::drivetrain::chassis.moveToPoint(37.585, 31.468, 1000, {.forwards = false});
-        robot::drivetrain::chassis.waitUntilDone();
-        robot::mechanisms::doinker.set_value(false);
-        autosetting::run_intake(4000);
-        robot::drivetrain::chassis.turnToPoint(41.178, 12.825, 1000);
-        robot::drivetrain::chassis.moveToPoint(41.178, 12.825, 1000);
-        pros::delay(200);
-        robot::drivetrain::chassis.turnToPoint(35.546, 6.222, 800);
-        robot::drivetrain::chassis.moveToPoint(35.546, 6.222, 1000);
-        robot::drivetrain::chassis.waitUntil(5);
-        robot::mechanisms::doinker.set_value(true);
-
-    } catch (const std::exception& e) {
-        pros::lcd::print(0, "One Stake Blue Auto Error: %s", e.what());
-                        }
-                    }
+    robot::drivetrain::chassis.setFieldTransform(pathing::FieldTransform::FLIP_X);
+    red_ring_auto();
+    robot::drivetrain::chassis.setFieldTransform(pathing::FieldTransform::NONE);
+}
 /*
           0
      270     90
          180
 *///55
 
-ASSET(BlueStakeRush_txt);
-ASSET(BlueStakeReturn_txt);
+// Not red_stake_auto mirrored: it opens with the red rush, then relocalizes and runs its own second half
 void blue_stake_auto() {
     float ring1x = 12.421;
     float ring1y = -59.028;
@@ -501,45 +461,45 @@ void blue_stake_auto() {
     float stake2y = -7.76;
     try {
         robot::drivetrain::chassis.setPose(-52.053, -59.611, 90);
-        robot::drivetrain::chassis.follow(RedStakeRush_txt, 10, 10000);
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.follow(redStakeRush, pathing::LookaheadPolicy::fixed(10), 10000).waitUntilDone();
         robot::mechanisms::doinker.set_value(true);
         pros::delay(100);
-        robot::drivetrain::chassis.follow(RedStakeReturn_txt, 10, 10000, false);
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.follow(redStakeReturn, pathing::LookaheadPolicy::fixed(10), 10000, false)
+            .waitUntilDone();
         robot::mechanisms::doinker.set_value(false);
-        robot::drivetrain::chassis.moveToPoint(-49.528, -60.194, 1000, {.forwards = false});
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.moveToPoint(-49.528, -60.194, 1000, {.forwards = false}).waitUntilDone();
         robot::drivetrain::chassis.setPose(49.528, -35.806, 270);
         
         robot::drivetrain::chassis.turnToPoint(20.189, -43.493, 1000, {.forwards = false});
-        robot::drivetrain::chassis.moveToPoint(20.189, -43.493, 1000, {.forwards = false, .maxSpeed = 60});
-        robot::drivetrain::chassis.waitUntil(32);
-        robot::mechanisms::clamp.set_value(true);
+        // the move is only 30", so the clamp closes as it ends
+        autosetting::clamp_at(32);
+        robot::drivetrain::chassis.moveToPoint(20.189, -43.493, 1000, {.forwards = false, .maxSpeed = 60})
+            .waitUntilDone();
         autosetting::run_intake(1700);
         pros::delay(200);
         robot::drivetrain::chassis.moveToPoint(54.95, -41.162, 1500);
-        robot::drivetrain::chassis.turnToPoint(ring1x, ring1y, 1000);
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.turnToPoint(ring1x, ring1y, 1000).waitUntilDone();
         robot::mechanisms::clamp.set_value(false);
 
 
         // Day 2 stuff (need tuning)
-        robot::drivetrain::chassis.moveToPoint(ring1x, ring1y, 1500, {.minSpeed = 127, .earlyExitRange = 15}); // 35.7
-        robot::drivetrain::chassis.waitUntilDone();  
-        autosetting::run_intake(1000); 
-        robot::drivetrain::chassis.moveToPoint(ring1x, ring1y, 1000, {.maxSpeed = 80});
+        // 35.7" to the ring
+        robot::drivetrain::chassis.addMarker(motion::Marker::atIndex(1, []() { autosetting::run_intake(1000); }));
+        robot::drivetrain::chassis.queueMoveToPoint(ring1x, ring1y, 1500, {.blendRadius = 15});
+        robot::drivetrain::chassis.queueMoveToPoint(ring1x, ring1y, 1000, {.maxSpeed = 80});
+        robot::drivetrain::chassis.runQueue();
         robot::drivetrain::chassis.turnToPoint(stake2x, stake2y, 1000, {.forwards = false});
-        robot::drivetrain::chassis.moveToPoint(stake2x, stake2y, 1500, {.forwards = false, .minSpeed = 127, .earlyExitRange = 30});
-        robot::drivetrain::chassis.moveToPoint(stake2x, stake2y, 1500, {.forwards = false, .maxSpeed = 70});
-        robot::drivetrain::chassis.waitUntil(10);
-        robot::mechanisms::clamp.set_value(true);
+        // 54" to the stake, so the second move takes over 24" in
+        robot::drivetrain::chassis.queueMoveToPoint(stake2x, stake2y, 1500, {.forwards = false, .blendRadius = 30});
+        robot::drivetrain::chassis.queueMoveToPoint(stake2x, stake2y, 1500, {.forwards = false, .maxSpeed = 70});
+        autosetting::clamp_at(34);
+        // only the intake waits for the clamp
+        robot::drivetrain::chassis.runQueue().waitUntil(34);
         
         pros::delay(300);
         autosetting::run_intake(3000);
         pros::delay(300);
-        robot::drivetrain::chassis.turnToHeading(17, 1000);
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.turnToHeading(17, 1000).waitUntilDone();
         robot::mechanisms::doinker.set_value(true);
 
         
@@ -566,6 +526,11 @@ void test_auto() {
 }
 
 void autonomous() {
+    // characterization only drives, the intake and LB tasks stay off
+    if (current_auto == AutonomousMode::CHARACTERIZE) {
+        characterize_drivetrain();
+        return;
+    }
     robot::mechanisms::intakeMotor.move_velocity(200);
     std::cout << "Running Auto" << std::endl;
     // Create task at start of autonomous
@@ -595,10 +560,34 @@ void autonomous() {
             case AutonomousMode::LIAM_SKILLS:
             liam_skills();
             break;
+        case AutonomousMode::CHARACTERIZE:
+            break;
     }
 }
 
-ASSET(rings_txt);
+void characterize_drivetrain() {
+    // each forward test is followed by a backward one, so the robot ends up back near where it started
+    const motion::SysIdTest tests[] = {motion::SysIdTest::QUASISTATIC_FORWARD, motion::SysIdTest::QUASISTATIC_BACKWARD,
+                                       motion::SysIdTest::DYNAMIC_FORWARD, motion::SysIdTest::DYNAMIC_BACKWARD};
+    std::vector<motion::SysIdSample> samples;
+    for (motion::SysIdTest test : tests) {
+        const std::vector<motion::SysIdSample> run = robot::drivetrain::chassis.characterize(test);
+        samples.insert(samples.end(), run.begin(), run.end());
+        pros::delay(1000); // let the robot come to a stop
+    }
+
+    // the terminal log can be fitted again on the host with tools/sysid
+    const motion::SysIdFit fit = motion::fitFeedforward(samples);
+    printf("left  kS %.2f kV %.3f kA %.3f r^2 %.4f\n", fit.left.kS, fit.left.kV, fit.left.kA, fit.leftR2);
+    printf("right kS %.2f kV %.3f kA %.3f r^2 %.4f\n", fit.right.kS, fit.right.kV, fit.right.kA, fit.rightR2);
+    printf("max velocity %.1f in/s, max acceleration %.0f in/s^2\n", fit.maxVelocity, fit.maxAcceleration);
+    pros::lcd::print(4, "L kS %.2f kV %.3f kA %.3f", fit.left.kS, fit.left.kV, fit.left.kA);
+    pros::lcd::print(5, "R kS %.2f kV %.3f kA %.3f", fit.right.kS, fit.right.kV, fit.right.kA);
+    pros::lcd::print(6, "%.1f in/s %.0f in/s^2", fit.maxVelocity, fit.maxAcceleration);
+}
+
+PATH_ASSET(rings);
+static const pathing::PathHandle ringsPath = paths.add("rings", rings_path);
 void liam_skills() {
     // Q1
     // Ring 1
@@ -658,22 +647,18 @@ void liam_skills() {
       //  autosetting::run_LB(25000);
       //  pros::delay(600);
 
-        robot::drivetrain::chassis.moveToPoint(-47, 0, 1000, {.forwards = false});
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.moveToPoint(-47, 0, 1000, {.forwards = false}).waitUntilDone();
         autosetting::run_LB(0);
 
 
         robot::drivetrain::chassis.turnToHeading(180, 1000);
-        robot::drivetrain::chassis.moveToPoint(-47, 26.03, 1000, {.forwards = false, .maxSpeed = 60});
-        robot::drivetrain::chassis.waitUntil(21); // 11 
-        robot::mechanisms::clamp.set_value(true);
-        robot::drivetrain::chassis.waitUntilDone();
+        autosetting::clamp_at(21);
+        robot::drivetrain::chassis.moveToPoint(-47, 26.03, 1000, {.forwards = false, .maxSpeed = 60}).waitUntilDone();
         robot::mechanisms::lbMotor.set_brake_mode(pros::E_MOTOR_BRAKE_COAST);
         robot::mechanisms::lbMotor.move_velocity(0);
 
         // Q1 ---
-        robot::drivetrain::chassis.turnToPoint(point1x, point1y, 1000); 
-        robot::drivetrain::chassis.waitUntilDone();  
+        robot::drivetrain::chassis.turnToPoint(point1x, point1y, 1000).waitUntilDone();
         autosetting::run_intake(25000);
         autosetting::pickup_ring(point1x, point1y, 9, 4); //1111111
 
@@ -700,32 +685,34 @@ void liam_skills() {
         
         robot::drivetrain::chassis.turnToPoint(point7x, point7y, 700, {.forwards = false});
         robot::drivetrain::chassis.moveToPoint(point7x, point7y, 2000, {.forwards = false, .minSpeed = 127, .earlyExitRange = 22});
-        robot::drivetrain::chassis.moveToPose(point7x, point7y, 0, 1500, {.forwards = false, .maxSpeed = 45});
-        //robot::drivetrain::chassis.waitUntil(53); // travles total 60.396 in (12)
+        motion::MotionHandle stakeMove = robot::drivetrain::chassis.moveToPose(point7x, point7y, 0, 1500, {.forwards = false, .maxSpeed = 45});
+        //stakeMove.waitUntil(53); // travles total 60.396 in (12)
         //maybe delete below if bad
-        robot::drivetrain::chassis.waitUntilDone();
+        stakeMove.waitUntilDone();
         //----------------------------------------
         robot::mechanisms::clamp.set_value(true);
         pros::delay(750);
         
-        robot::drivetrain::chassis.turnToPoint(point8x, point8y, 1000); 
-        robot::drivetrain::chassis.waitUntilDone();
+        robot::drivetrain::chassis.turnToPoint(point8x, point8y, 1000).waitUntilDone();
         autosetting::run_intake(20000);
-        robot::drivetrain::chassis.moveToPoint(point8x, point8y, 1000, {.minSpeed = 120, .earlyExitRange = 20});
-        robot::drivetrain::chassis.moveToPoint(point8x, point8y, 1000, {.maxSpeed = 70});
+        robot::drivetrain::chassis.queueMoveToPoint(point8x, point8y, 1000, {.maxSpeed = 120, .blendRadius = 20});
+        robot::drivetrain::chassis.queueMoveToPoint(point8x, point8y, 1000, {.maxSpeed = 70});
+        robot::drivetrain::chassis.runQueue();
         pros::delay(200);
         //idfk kms I hate everything
         robot::drivetrain::chassis.turnToPoint(point9x, point9y, 1000);
-        robot::drivetrain::chassis.moveToPoint(point9x, point9y, 1500, {.minSpeed = 127, .earlyExitRange = 20});  
-        robot::drivetrain::chassis.moveToPoint(point9x, point9y, 1500, {.maxSpeed = 70});
+        robot::drivetrain::chassis.queueMoveToPoint(point9x, point9y, 1500, {.blendRadius = 20});
+        robot::drivetrain::chassis.queueMoveToPoint(point9x, point9y, 1500, {.maxSpeed = 70});
+        robot::drivetrain::chassis.runQueue();
         
         pros::delay(200);
         robot::drivetrain::chassis.turnToPoint(point10x, point10y, 1000);
         robot::drivetrain::chassis.moveToPoint(point10x, point10y, 4000, {.maxSpeed = 50});
         pros::delay(200);
         robot::drivetrain::chassis.turnToPoint(point11x, point11y, 1000);
-        robot::drivetrain::chassis.moveToPoint(point11x, point11y, 1500, {.minSpeed = 127, .earlyExitRange = 20});
-        robot::drivetrain::chassis.moveToPoint(point11x, point11y, 1500, {.maxSpeed = 70});
+        robot::drivetrain::chassis.queueMoveToPoint(point11x, point11y, 1500, {.blendRadius = 20});
+        robot::drivetrain::chassis.queueMoveToPoint(point11x, point11y, 1500, {.maxSpeed = 70});
+        robot::drivetrain::chassis.runQueue();
         pros::delay(200);
         robot::drivetrain::chassis.turnToPoint(point12x, point12y, 1000, {.forwards = false});
         robot::drivetrain::chassis.moveToPoint(point12x, point12y, 1500, {.forwards = false, .maxSpeed = 70});
@@ -742,3 +729,15 @@ void liam_skills() {
         pros::lcd::print(0, "Skills Auto Error: %s", e.what());
     };
 }
+
+void load_paths() {
+    const size_t failed = paths.load(pros::micros);
+    for (size_t i = 0; i < paths.size(); i++) {
+        const pathing::PathRegistry::Entry& entry = paths.entry({&paths, uint16_t(i)});
+        printf("path %-16s %5u points %6u bytes %5u us %s\n", entry.name, unsigned(entry.count),
+               unsigned(entry.source.size + entry.arenaBytes), unsigned(entry.loadMicros),
+               pathing::toString(entry.result));
+    }
+    printf("paths: %u loaded, %u failed, %u byte arena\n", unsigned(paths.size() - failed), unsigned(failed),
+           unsigned(paths.arenaSize()));
+}
@@ -65,8 +65,110 @@ namespace robot {
             0   // slew rate
         );  
 
+        // Settle conditions for moves and turns, applied in initialize(). A motion ends once the robot is stopped
+        // close to the target, instead of waiting out the exit timeouts above, which are kept as the fallback
+        motion::SettleCondition lateralSettle(
+            (motion::SettleCondition::error(1) & motion::SettleCondition::velocity(2, 30)) | // stopped within 1"
+            (motion::SettleCondition::error(3) & motion::SettleCondition::velocity(1, 50)) | // stalled within 3"
+            motion::SettleCondition::error(1, 100) | // small error range and timeout
+            motion::SettleCondition::error(3, 500)   // large error range and timeout
+        );
+        motion::SettleCondition angularSettle(
+            (motion::SettleCondition::error(1) & motion::SettleCondition::velocity(10, 30)) | // stopped within 1 deg
+            (motion::SettleCondition::error(3) & motion::SettleCondition::velocity(5, 50)) | // stalled within 3 deg
+            motion::SettleCondition::error(1, 100) | // small error range and timeout
+            motion::SettleCondition::error(3, 500)   // large error range and timeout
+        );
+
+        // Timeouts for motions called with motion::AUTO_TIMEOUT, applied in initialize(). In bench_timeout turns take
+        // up to 1.4 times the time estimated from the feedforward below, and moves up to 1.05 times
+        motion::TimeoutParams motionTimeouts(
+            1.5,  // margin, timeout as a multiple of the expected duration
+            300,  // settle time, in milliseconds, added to motions that stop on their target
+            300,  // shortest timeout, in milliseconds
+            5000  // longest timeout, in milliseconds, also used when a motion's duration can't be estimated
+        );
+
+        // Motion profile for moveToPoint and moveToPose, applied in initialize(). Off until the limits are measured
+        // on the robot. In bench_profile a 70 in/s, 200 in/s^2 trapezoid only ties the lateral PID alone (4.88 s over
+        // its six moves) with feedforward matched to the drivetrain, and takes 5.21 s with the free speed feedforward
+        // below. An S-curve is slower still
+        pathing::ProfileLimits lateralProfile(
+            0, // max velocity, in inches per second. 0 leaves moves on the lateral PID
+            0, // max acceleration, in inches per second squared
+            0  // max jerk, in inches per second cubed. 0 for a trapezoidal profile
+        );
+
+        // Motion profile for turnToHeading and turnToPoint, applied in initialize(). Off until the limits are
+        // measured: 540 deg/s and 2700 deg/s^2 are guesses that bench_turn runs on the simulated robot, not a fit.
+        // Fill the acceleration in from the kS and kA tools/sysid fits to the CHARACTERIZE logs: (127 - kS) / kA is
+        // the wheel acceleration from rest at full power, divide it by half the track width and convert to degrees,
+        // less a margin for the wheels slipping
+        pathing::ProfileLimits angularProfile(
+            0, // max angular velocity, in degrees per second. 0 leaves turns on the angular PID
+            0, // max angular acceleration, in degrees per second squared
+            0  // max angular jerk, in degrees per second cubed. 0 for a trapezoidal profile
+        );
+
+        // Gains for carrying a mobile goal, added in initialize() as "goal". Untuned: the goal adds mass and turning
+        // inertia, so turns get less kP and more kD, but none of it has been tried on the robot. Routines can pick it
+        // with useGainSet("goal"). Once it is tuned, pass mechanisms::clampClosed to addGainSet() so it is used
+        // whenever the clamp is closed. The gains above stay as the "default" set for an empty robot
+        motion::GainSet goalGains(
+            lemlib::ControllerSettings(
+                10,  // kP
+                0,   // kI
+                9,   // kD
+                3,   // anti windup
+                1,   // small error range, in inches
+                100, // small error range timeout, in milliseconds
+                3,   // large error range, in inches
+                500, // large error range timeout, in milliseconds
+                20   // maximum acceleration (slew)
+            ),
+            lemlib::ControllerSettings(
+                1.6, // kP
+                0,   // kI
+                14,  // kD
+                3,   // anti-windup
+                1,   // small error range
+                100, // small error timeout
+                3,   // large error range
+                500, // large error timeout
+                0    // slew rate
+            ),
+            lateralSettle,
+            angularSettle
+        );
+
+        // How profiled motions, trajectories and RAMSETE drive the motors, applied in initialize(). In bench_velocity
+        // LOOP with a gain of 3 cuts how far RAMSETE falls behind a trajectory on a 90% battery from 1.04" to 0.70"
+        motion::VelocityControl velocityControl(motion::VelocityControl::VOLTAGE);
+        float velocityKP(3); // LOOP only, power per inch per second of wheel velocity error
+
+        // Physical speed limits for following paths, applied in initialize(). Off until the real limits are measured on
+        // carpet. In bench_speed 150 in/s^2 sideways and 200 in/s^2 braking get AutoSkillRoute and rings.txt to the
+        // end of the path, but RedRingSide strays further from it (103" against 81") and a.txt takes 0.65 s longer
+        pathing::SpeedLimits pathSpeedLimits(
+            INFINITY, // max lateral acceleration before the wheels slide, in inches per second squared
+            INFINITY  // max deceleration, in inches per second squared
+        );
+
+        // Feedforward for each side of the drivetrain, applied in initialize(). These are the free speed of the
+        // wheels and a 100ms motor response, replace them with the gains the CHARACTERIZE autonomous prints
+        motion::Feedforward leftFeedforward(
+            0,     // kS, power to get moving
+            1.66,  // kV, power per inch per second
+            0.166  // kA, power per inch per second squared
+        );
+        motion::Feedforward rightFeedforward(
+            0,     // kS
+            1.66,  // kV
+            0.166  // kA
+        );
+
         // Chassis instance
-        lemlib::Chassis chassis(
+        motion::Chassis chassis(
             drivetrain,
             lateralController,
             angularController,
@@ -87,6 +189,9 @@ namespace robot {
         pros::ADIDigitalOut clamp('H');
         pros::ADIDigitalOut doinker('G');
         pros::ADIDigitalOut intake('B');
+
+        // a digital out can't be read back, but its port keeps the value last written to it
+        bool clampClosed() { return pros::c::adi_port_get_value('H') != 0; }
     } 
     namespace pid {
         // PID gains account for conversion from centidegrees to RPM
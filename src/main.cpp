@@ -237,9 +237,18 @@ void initialize() {
     pros::lcd::initialize(); // initialize brain screen
     
     robot::drivetrain::chassis.calibrate(); // calibrate sensors
+    robot::drivetrain::chassis.setSettleConditions(robot::drivetrain::lateralSettle, robot::drivetrain::angularSettle);
+    robot::drivetrain::chassis.setTimeoutParams(robot::drivetrain::motionTimeouts);
+    robot::drivetrain::chassis.setLateralProfile(robot::drivetrain::lateralProfile);
+    robot::drivetrain::chassis.setAngularProfile(robot::drivetrain::angularProfile);
+    robot::drivetrain::chassis.addGainSet("goal", robot::drivetrain::goalGains);
+    robot::drivetrain::chassis.setVelocityControl(robot::drivetrain::velocityControl, robot::drivetrain::velocityKP);
+    robot::drivetrain::chassis.setPathSpeedLimits(robot::drivetrain::pathSpeedLimits);
+    robot::drivetrain::chassis.setFeedforward(robot::drivetrain::leftFeedforward, robot::drivetrain::rightFeedforward);
     robot::mechanisms::lbMotor.set_brake_mode(pros::E_MOTOR_BRAKE_COAST);
     robot::drivetrain::chassis.setBrakeMode(pros::E_MOTOR_BRAKE_HOLD);
     robot::mechanisms::lbRotationSensor.reset_position();
+    load_paths(); // parse and check every path now instead of when a routine follows it
     // print position to brain screen
     pros::Task screen_task([&]() { 
         while (true) {
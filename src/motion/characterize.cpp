@@ -0,0 +1,60 @@
+#include <cstdio>
+#include "motion/chassis.hpp"
+
+/**
+ * @brief the average velocity of a side's motors, converted to inches per second at the wheel
+ *
+ * @param fullSpeed wheel speed at full power, inches per second
+ */
+static float sideVelocity(const pros::MotorGroup& motors, float fullSpeed) {
+    // each motor's speed as a fraction of its cartridge's, so the gearing to the wheels is the drivetrain's rpm. A
+    // motor whose gearing can't be read is unplugged and left out
+    float fraction = 0;
+    int count = 0;
+    for (int i = 0; i < motors.size(); i++) {
+        const float rpm = motion::cartridgeRpm(motors.get_gearing(i));
+        if (rpm == 0) continue;
+        fraction += motors.get_actual_velocity(i) / rpm;
+        count++;
+    }
+    return count > 0 ? fraction / count * fullSpeed : 0;
+}
+
+std::vector<motion::SysIdSample> motion::Chassis::characterize(SysIdTest test, SysIdParams params) {
+    std::vector<SysIdSample> samples;
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return samples;
+
+    const float duration = sysIdDuration(test, params);
+    samples.reserve(size_t(duration * 100) + 1);
+    lemlib::Pose lastPose = this->getPose(true);
+    const uint32_t start = pros::millis();
+    distTraveled = 0;
+
+    while (this->motionRunning) {
+        const float time = (pros::millis() - start) / 1000.0f;
+        if (time >= duration) break;
+        const lemlib::Pose pose = this->getPose(true);
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // sample the velocity the voltage so far has produced, then apply the next voltage
+        const float voltage = sysIdVoltage(test, time, params);
+        const SysIdSample sample = {time, voltage, sideVelocity(*drivetrain.leftMotors, wheelSpeed(drivetrain)),
+                                    sideVelocity(*drivetrain.rightMotors, wheelSpeed(drivetrain))};
+        samples.push_back(sample);
+        printf("sysid,%.3f,%.3f,%.3f,%.3f\n", sample.time, sample.voltage, sample.leftVelocity, sample.rightVelocity);
+        drivetrain.leftMotors->move_voltage(voltage * 1000);
+        drivetrain.rightMotors->move_voltage(voltage * 1000);
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+    return samples;
+}
@@ -0,0 +1,320 @@
+#include <cmath>
+#include "lemlib/chassis/odom.hpp"
+#include "pros/misc.hpp"
+#include "motion/chassis.hpp"
+
+void motion::Chassis::setFieldTransform(pathing::FieldTransform transform) { fieldTransform = transform; }
+
+pathing::FieldTransform motion::Chassis::getFieldTransform() const { return fieldTransform; }
+
+lemlib::AngularDirection motion::Chassis::transformDirection(lemlib::AngularDirection direction) const {
+    if (!pathing::mirrorsHandedness(fieldTransform)) return direction;
+    switch (direction) {
+        case lemlib::AngularDirection::CW_CLOCKWISE: return lemlib::AngularDirection::CCW_COUNTERCLOCKWISE;
+        case lemlib::AngularDirection::CCW_COUNTERCLOCKWISE: return lemlib::AngularDirection::CW_CLOCKWISE;
+        default: return direction;
+    }
+}
+
+lemlib::DriveSide motion::Chassis::transformSide(lemlib::DriveSide side) const {
+    if (!pathing::mirrorsHandedness(fieldTransform)) return side;
+    return side == lemlib::DriveSide::LEFT ? lemlib::DriveSide::RIGHT : lemlib::DriveSide::LEFT;
+}
+
+void motion::Chassis::setFeedforward(Feedforward left, Feedforward right) {
+    leftFeedforward = left;
+    rightFeedforward = right;
+}
+
+void motion::Chassis::setFeedforward(Feedforward both) { setFeedforward(both, both); }
+
+motion::Feedforward motion::Chassis::sideFeedforward(lemlib::DriveSide side) const {
+    const Feedforward& gains = side == lemlib::DriveSide::LEFT ? leftFeedforward : rightFeedforward;
+    if (gains.enabled()) return gains;
+    // full power reaches the free speed of the wheels, and the motors take about 100ms to get to a new speed
+    const float kV = 127 / wheelSpeed(drivetrain);
+    return {0, kV, kV * 0.1f};
+}
+
+void motion::Chassis::setPose(float x, float y, float theta, bool radians) {
+    lemlib::Chassis::setPose(pathing::transformX(fieldTransform, x), pathing::transformY(fieldTransform, y),
+                             pathing::transformHeading(fieldTransform, theta, radians), radians);
+}
+
+void motion::Chassis::setPose(lemlib::Pose pose, bool radians) { setPose(pose.x, pose.y, pose.theta, radians); }
+
+void motion::Chassis::addMarker(Marker marker) { pendingMarkers.add(std::move(marker)); }
+
+motion::MarkerList motion::Chassis::takeMarkers() {
+    MarkerList markers;
+    std::swap(markers, pendingMarkers);
+    return markers;
+}
+
+void motion::Chassis::cancelMotion() {
+    cancelCount++;
+    lemlib::Chassis::cancelMotion();
+}
+
+void motion::Chassis::cancelAllMotions() {
+    cancelCount++;
+    cancelAllCount++;
+    lemlib::Chassis::cancelAllMotions();
+}
+
+void motion::Chassis::setSettleConditions(SettleCondition lateral, SettleCondition angular) {
+    gainSets.front().gains.lateralSettle = lateral;
+    gainSets.front().gains.angularSettle = angular;
+    if (activeGains != 0) return;
+    lateralSettle = lateral;
+    angularSettle = angular;
+}
+
+void motion::Chassis::setTimeoutParams(TimeoutParams params) { timeoutParams = params; }
+
+motion::DurationModel motion::Chassis::durationModel() const {
+    const Feedforward left = sideFeedforward(lemlib::DriveSide::LEFT);
+    const Feedforward right = sideFeedforward(lemlib::DriveSide::RIGHT);
+    return DurationModel({(left.kS + right.kS) / 2, (left.kV + right.kV) / 2, (left.kA + right.kA) / 2},
+                         drivetrain.trackWidth);
+}
+
+uint32_t motion::Chassis::expectedTime(float seconds, bool settles) const {
+    return uint32_t(std::lround(seconds * 1000)) + (settles ? timeoutParams.settleTime : 0);
+}
+
+lemlib::Pose motion::Chassis::expectedStart() { return this->isInMotion() ? plannedEnd : getPose(); }
+
+bool motion::Chassis::exitMet(SettleCondition& settle, lemlib::ExitCondition& smallExit,
+                              lemlib::ExitCondition& largeExit, float error, float velocity) {
+    if (!settle.empty()) return settle.update(error, velocity, pros::millis());
+    const bool met = smallExit.getExit() || largeExit.getExit();
+    smallExit.update(error);
+    largeExit.update(error);
+    return met;
+}
+
+motion::MotionResult motion::Chassis::loopResult(bool settled, int compState) const {
+    if (settled) return MotionResult::SETTLED;
+    if (!this->motionRunning) return MotionResult::CANCELLED;
+    if (pros::competition::get_status() != compState) return MotionResult::INTERRUPTED;
+    return MotionResult::TIMEOUT;
+}
+
+motion::MotionHandle motion::Chassis::watchMotion(const std::function<void()>& start, float planned, int timeout,
+                                                  uint32_t expected, bool async, ErrorFunction lateralError,
+                                                  ErrorFunction angularError) {
+    MarkerList markers = takeMarkers();
+    MotionHandle handle;
+    // take the chassis like any other motion, which switches the gains while nothing can be running on them, then
+    // hand it over to LemLib's motion
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return handle;
+    }
+    const uint32_t generation = motionGeneration;
+    watchedGeneration = generation;
+    SettleCondition lateral = lateralError ? lateralSettle : SettleCondition();
+    SettleCondition angular = angularError ? angularSettle : SettleCondition();
+    this->endMotion();
+    const uint32_t cancels = cancelCount;
+    const int compState = pros::competition::get_status();
+    start();
+    handle.start(expected);
+    // LemLib's async motions return 10ms after they start
+    const uint32_t startTime = pros::millis() - 10;
+    pros::Task task([this, markers, handle, planned, timeout, cancels, compState, startTime, generation, lateralError,
+                     angularError, lateral, angular]() mutable {
+        // the motion starts in its own task, give it a moment to reset distTraveled
+        while (distTraveled < 0 && motionGeneration == generation && pros::millis() - startTime < 60) {
+            pros::delay(5);
+        }
+        // the motion is over once distTraveled is -1, or once the next motion has taken the chassis. Every motion
+        // bumps the generation before it resets distTraveled, so reading it second can't miss the handover
+        bool settled = false;
+        while (true) {
+            const float traveled = distTraveled;
+            if (traveled < 0 || motionGeneration != generation) break;
+            markers.update(traveled, 0, planned > 0 ? traveled / planned : 0);
+            handle.update(traveled);
+            if (!settled && (!lateral.empty() || !angular.empty())) {
+                const lemlib::Pose pose = getPose();
+                const lemlib::Pose speed = lemlib::getSpeed();
+                const uint32_t now = pros::millis();
+                settled = (lateral.empty() || lateral.update(lateralError(pose), std::hypot(speed.x, speed.y), now)) &&
+                          (angular.empty() || angular.update(angularError(pose), speed.theta, now));
+                // stop the motion, and keep watching until it has ended so the next one can't start before it does.
+                // Nothing else can take the chassis while this watch runs (see requestMotionStart()), so as long as
+                // the generation matches the cancel can only land on this motion
+                if (settled && motionGeneration == generation) lemlib::Chassis::cancelMotion();
+            }
+            pros::delay(10);
+        }
+        if (watchedGeneration == generation) watchedGeneration = 0;
+        // LemLib doesn't say why its motions end, so work it out. A motion that settles in its last 10ms counts as
+        // timed out
+        MotionResult result = MotionResult::SETTLED;
+        if (settled) {
+            result = MotionResult::SETTLED;
+        } else if (cancelCount != cancels) {
+            result = MotionResult::CANCELLED;
+        } else if (pros::competition::get_status() != compState) {
+            result = MotionResult::INTERRUPTED;
+        } else if (pros::millis() - startTime >= uint32_t(timeout)) {
+            result = MotionResult::TIMEOUT;
+        }
+        markers.finish(result);
+        handle.finish(result);
+    });
+    if (!async) handle.waitUntilDone();
+    return handle;
+}
+
+motion::MotionHandle motion::Chassis::turnToPoint(float x, float y, int timeout, lemlib::TurnToPointParams params,
+                                                  bool async) {
+    params.direction = transformDirection(params.direction);
+    x = pathing::transformX(fieldTransform, x);
+    y = pathing::transformY(fieldTransform, y);
+    const auto target = [x, y, forwards = params.forwards](const lemlib::Pose& pose) {
+        return lemlib::radToDeg(std::atan2(x - pose.x, y - pose.y)) + (forwards ? 0 : 180);
+    };
+    const ErrorFunction error = [target](const lemlib::Pose& pose) {
+        return lemlib::angleError(target(pose), pose.theta, false);
+    };
+    const lemlib::Pose from = expectedStart();
+    const float angle = lemlib::angleError(target(from), from.theta, false, params.direction);
+    plannedEnd = {from.x, from.y, target(from)};
+    if (profiled(nextGains().angularProfile, params.minSpeed, params.earlyExitRange)) {
+        MotionHandle handle;
+        profiledTurn(x, y, NAN, params.forwards, params.direction, false, lemlib::DriveSide::LEFT, timeout,
+                     params.maxSpeed, async, takeMarkers(), handle);
+        return handle;
+    }
+    const uint32_t expected = expectedTime(durationModel().turn(angle, params.maxSpeed), params.minSpeed == 0);
+    timeout = timeoutParams.resolve(timeout, expected);
+    return watchMotion([&]() { lemlib::Chassis::turnToPoint(x, y, timeout, params, true); }, std::fabs(angle),
+                       timeout, expected, async, nullptr, params.minSpeed == 0 ? error : nullptr);
+}
+
+motion::MotionHandle motion::Chassis::turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params,
+                                                    bool async) {
+    params.direction = transformDirection(params.direction);
+    theta = pathing::transformHeading(fieldTransform, theta);
+    const ErrorFunction error = [theta](const lemlib::Pose& pose) {
+        return lemlib::angleError(theta, pose.theta, false);
+    };
+    const lemlib::Pose from = expectedStart();
+    const float angle = lemlib::angleError(theta, from.theta, false, params.direction);
+    plannedEnd = {from.x, from.y, theta};
+    if (profiled(nextGains().angularProfile, params.minSpeed, params.earlyExitRange)) {
+        MotionHandle handle;
+        profiledTurn(0, 0, theta, true, params.direction, false, lemlib::DriveSide::LEFT, timeout, params.maxSpeed,
+                     async, takeMarkers(), handle);
+        return handle;
+    }
+    const uint32_t expected = expectedTime(durationModel().turn(angle, params.maxSpeed), params.minSpeed == 0);
+    timeout = timeoutParams.resolve(timeout, expected);
+    return watchMotion([&]() { lemlib::Chassis::turnToHeading(theta, timeout, params, true); }, std::fabs(angle),
+                       timeout, expected, async, nullptr, params.minSpeed == 0 ? error : nullptr);
+}
+
+motion::MotionHandle motion::Chassis::swingToHeading(float theta, lemlib::DriveSide lockedSide, int timeout,
+                                                     lemlib::SwingToHeadingParams params, bool async) {
+    params.direction = transformDirection(params.direction);
+    theta = pathing::transformHeading(fieldTransform, theta);
+    const ErrorFunction error = [theta](const lemlib::Pose& pose) {
+        return lemlib::angleError(theta, pose.theta, false);
+    };
+    const lemlib::Pose from = expectedStart();
+    const float angle = lemlib::angleError(theta, from.theta, false, params.direction);
+    // the robot's center moves around the locked side, but not far enough to matter to the next estimate
+    plannedEnd = {from.x, from.y, theta};
+    if (profiled(nextGains().angularProfile, params.minSpeed, params.earlyExitRange)) {
+        MotionHandle handle;
+        profiledTurn(0, 0, theta, true, params.direction, true, transformSide(lockedSide), timeout, params.maxSpeed,
+                     async, takeMarkers(), handle);
+        return handle;
+    }
+    const uint32_t expected = expectedTime(durationModel().swing(angle, params.maxSpeed), params.minSpeed == 0);
+    timeout = timeoutParams.resolve(timeout, expected);
+    return watchMotion(
+        [&]() { lemlib::Chassis::swingToHeading(theta, transformSide(lockedSide), timeout, params, true); },
+        std::fabs(angle), timeout, expected, async, nullptr, params.minSpeed == 0 ? error : nullptr);
+}
+
+motion::MotionHandle motion::Chassis::swingToPoint(float x, float y, lemlib::DriveSide lockedSide, int timeout,
+                                                   lemlib::SwingToPointParams params, bool async) {
+    params.direction = transformDirection(params.direction);
+    x = pathing::transformX(fieldTransform, x);
+    y = pathing::transformY(fieldTransform, y);
+    const auto target = [x, y, forwards = params.forwards](const lemlib::Pose& pose) {
+        return lemlib::radToDeg(std::atan2(x - pose.x, y - pose.y)) + (forwards ? 0 : 180);
+    };
+    const ErrorFunction error = [target](const lemlib::Pose& pose) {
+        return lemlib::angleError(target(pose), pose.theta, false);
+    };
+    const lemlib::Pose from = expectedStart();
+    const float angle = lemlib::angleError(target(from), from.theta, false, params.direction);
+    plannedEnd = {from.x, from.y, target(from)};
+    if (profiled(nextGains().angularProfile, params.minSpeed, params.earlyExitRange)) {
+        MotionHandle handle;
+        profiledTurn(x, y, NAN, params.forwards, params.direction, true, transformSide(lockedSide), timeout,
+                     params.maxSpeed, async, takeMarkers(), handle);
+        return handle;
+    }
+    const uint32_t expected = expectedTime(durationModel().swing(angle, params.maxSpeed), params.minSpeed == 0);
+    timeout = timeoutParams.resolve(timeout, expected);
+    return watchMotion(
+        [&]() { lemlib::Chassis::swingToPoint(x, y, transformSide(lockedSide), timeout, params, true); },
+        std::fabs(angle), timeout, expected, async, nullptr, params.minSpeed == 0 ? error : nullptr);
+}
+
+motion::MotionHandle motion::Chassis::moveToPose(float x, float y, float theta, int timeout,
+                                                 lemlib::MoveToPoseParams params, bool async) {
+    x = pathing::transformX(fieldTransform, x);
+    y = pathing::transformY(fieldTransform, y);
+    theta = pathing::transformHeading(fieldTransform, theta);
+    const lemlib::Pose from = expectedStart();
+    plannedEnd = {x, y, theta};
+    if (profiled(nextGains().lateralProfile, params.minSpeed, params.earlyExitRange)) {
+        MotionHandle handle;
+        profiledMove(x, y, theta, params.lead, timeout, params.forwards, params.maxSpeed, async, takeMarkers(),
+                     handle);
+        return handle;
+    }
+    const ErrorFunction distance = [x, y](const lemlib::Pose& pose) { return pose.distance(lemlib::Pose(x, y)); };
+    const ErrorFunction heading = [theta](const lemlib::Pose& pose) {
+        return lemlib::angleError(theta, pose.theta, false);
+    };
+    const bool settles = params.minSpeed == 0;
+    // backwards, the back of the robot drives the curve, so the curve leaves from the other way
+    const float curveTheta = lemlib::degToRad(theta) + (params.forwards ? 0 : M_PI);
+    const float length = boomerangLength(from, x, y, curveTheta, params.lead);
+    const uint32_t expected = expectedTime(durationModel().move(length, params.maxSpeed), settles);
+    timeout = timeoutParams.resolve(timeout, expected);
+    return watchMotion([&]() { lemlib::Chassis::moveToPose(x, y, theta, timeout, params, true); }, length, timeout,
+                       expected, async, settles ? distance : nullptr, settles ? heading : nullptr);
+}
+
+motion::MotionHandle motion::Chassis::moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params,
+                                                  bool async) {
+    x = pathing::transformX(fieldTransform, x);
+    y = pathing::transformY(fieldTransform, y);
+    const lemlib::Pose from = expectedStart();
+    // the robot ends facing the way it drove
+    plannedEnd = {x, y, lemlib::radToDeg(std::atan2(x - from.x, y - from.y)) + (params.forwards ? 0 : 180)};
+    if (profiled(nextGains().lateralProfile, params.minSpeed, params.earlyExitRange)) {
+        MotionHandle handle;
+        profiledMove(x, y, NAN, 0, timeout, params.forwards, params.maxSpeed, async, takeMarkers(), handle);
+        return handle;
+    }
+    const ErrorFunction error = [x, y](const lemlib::Pose& pose) { return pose.distance(lemlib::Pose(x, y)); };
+    const float distance = from.distance(lemlib::Pose(x, y));
+    const uint32_t expected = expectedTime(durationModel().move(distance, params.maxSpeed), params.minSpeed == 0);
+    timeout = timeoutParams.resolve(timeout, expected);
+    return watchMotion([&]() { lemlib::Chassis::moveToPoint(x, y, timeout, params, true); }, distance, timeout,
+                       expected, async, params.minSpeed == 0 ? error : nullptr);
+}
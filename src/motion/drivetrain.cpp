@@ -0,0 +1,16 @@
+#include <cmath>
+#include "motion/drivetrain.hpp"
+
+namespace motion {
+
+float cartridgeRpm(pros::MotorGears gears) {
+    switch (gears) {
+        case pros::MotorGears::ratio_36_to_1: return 100;
+        case pros::MotorGears::ratio_18_to_1: return 200;
+        case pros::MotorGears::ratio_6_to_1: return 600;
+        default: return 0;
+    }
+}
+
+float wheelSpeed(const lemlib::Drivetrain& drivetrain) { return drivetrain.rpm / 60 * M_PI * drivetrain.wheelDiameter; }
+} // namespace motion
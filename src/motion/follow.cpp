@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <cmath>
+#include "pros/misc.hpp"
+#include "motion/chassis.hpp"
+#include "path/pursuit.hpp"
+
+/**
+ * @brief curvature of the arc from the robot to the lookahead point
+ */
+static float findLookaheadCurvature(const lemlib::Pose& pose, float heading, const lemlib::Pose& lookahead) {
+    // which side of the robot the lookahead point is on
+    const float side =
+        lemlib::sgn(std::sin(heading) * (lookahead.x - pose.x) - std::cos(heading) * (lookahead.y - pose.y));
+    const float a = -std::tan(heading);
+    const float c = std::tan(heading) * pose.x - pose.y;
+    const float x = std::fabs(a * lookahead.x + lookahead.y + c) / std::sqrt((a * a) + 1);
+    const float d = std::hypot(lookahead.x - pose.x, lookahead.y - pose.y);
+    return side * ((2 * x) / (d * d));
+}
+
+/**
+ * @brief seconds to follow a path at its speeds, up to the first point with a speed of 0
+ *
+ * @param speeds capped speed of each point, or nullptr to use the path's own
+ */
+static float pathDuration(pathing::PathView path, const float* speeds, float fullSpeed) {
+    float seconds = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        const pathing::Point from = path[i - 1];
+        const pathing::Point to = path[i];
+        const float fromSpeed = speeds ? speeds[i - 1] : from.speed;
+        const float toSpeed = speeds ? speeds[i] : to.speed;
+        // speeds are motor power, full power is the free speed of the wheels
+        const float average = (fromSpeed + toSpeed) / 2 / 127 * fullSpeed;
+        if (average > 0) seconds += std::hypot(to.x - from.x, to.y - from.y) / average;
+        if (toSpeed == 0) break;
+    }
+    return seconds;
+}
+
+void motion::Chassis::setPathSpeedLimits(pathing::SpeedLimits limits) { pathSpeedLimits = limits; }
+
+motion::MotionHandle motion::Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards,
+                                             bool async) {
+    return follow(path, pathing::LookaheadPolicy::fixed(lookahead), timeout, forwards, async);
+}
+
+motion::MotionHandle motion::Chassis::follow(const asset& path, const pathing::LookaheadPolicy& lookahead,
+                                             int timeout, bool forwards, bool async) {
+    if (pathing::isTrajectory(path)) {
+        pathing::LoadResult result;
+        const pathing::TrajectoryView view = pathing::TrajectoryView::fromAsset(path, &result);
+        if (result != pathing::LoadResult::OK) {
+            lemlib::infoSink()->error("Cannot follow trajectory: {}. Skipping motion", pathing::toString(result));
+            takeMarkers().finish(MotionResult::SKIPPED);
+            return MotionHandle::ended(MotionResult::SKIPPED);
+        }
+        return follow(view, lookahead.maxLookahead, timeout, forwards, async);
+    }
+
+    // text paths are still handled by LemLib
+    if (!pathing::isBinary(path)) {
+        if (fieldTransform != pathing::FieldTransform::NONE) {
+            lemlib::infoSink()->warn("Field transform is not applied to text paths");
+        }
+        // there's no telling how long a text path takes without parsing it
+        timeout = timeoutParams.resolve(timeout, 0);
+        return watchMotion([&]() { lemlib::Chassis::follow(path, lookahead.maxLookahead, timeout, forwards, true); },
+                           0, timeout, 0, async);
+    }
+
+    if (pathing::isCompressed(path)) {
+        MotionHandle handle;
+        followCompressed(path, lookahead, timeout, forwards, async, takeMarkers(), handle);
+        return handle;
+    }
+
+    // the header and checksum are the only things checked before the robot moves
+    pathing::LoadResult result;
+    const pathing::PathView view = pathing::PathView::fromAsset(path, &result);
+    if (result != pathing::LoadResult::OK) {
+        lemlib::infoSink()->error("Cannot follow path: {}. Skipping motion", pathing::toString(result));
+        takeMarkers().finish(MotionResult::SKIPPED);
+        return MotionHandle::ended(MotionResult::SKIPPED);
+    }
+    return follow(view, lookahead, timeout, forwards, async);
+}
+
+motion::MotionHandle motion::Chassis::follow(pathing::PathView path, float lookahead, int timeout, bool forwards,
+                                             bool async) {
+    return follow(path, pathing::LookaheadPolicy::fixed(lookahead), timeout, forwards, async);
+}
+
+motion::MotionHandle motion::Chassis::follow(pathing::PathView path, const pathing::LookaheadPolicy& lookahead,
+                                             int timeout, bool forwards, bool async) {
+    path = path.transformed(fieldTransform);
+    if (path.size() > 1) {
+        // the robot ends facing along the last piece of the path
+        const pathing::Point last = path[path.size() - 1];
+        const pathing::Point before = path[path.size() - 2];
+        plannedEnd = {last.x, last.y,
+                      lemlib::radToDeg(std::atan2(last.x - before.x, last.y - before.y)) + (forwards ? 0 : 180)};
+    }
+    MotionHandle handle;
+    purePursuit(path, lookahead, timeout, forwards, async, takeMarkers(), handle);
+    return handle;
+}
+
+motion::MotionHandle motion::Chassis::follow(pathing::TrajectoryView trajectory, float lookahead, int timeout,
+                                             bool forwards, bool async) {
+    trajectory = trajectory.transformed(fieldTransform);
+    if (!trajectory.empty()) {
+        const pathing::TrajectorySample last = trajectory[trajectory.size() - 1];
+        plannedEnd = {last.x, last.y, last.heading + (forwards ? 0 : 180)};
+    }
+    MotionHandle handle;
+    trackTrajectory(trajectory, lookahead, timeout, forwards, async, takeMarkers(), handle);
+    return handle;
+}
+
+motion::MotionHandle motion::Chassis::follow(pathing::PathHandle path, float lookahead, int timeout, bool forwards,
+                                             bool async) {
+    return follow(path, pathing::LookaheadPolicy::fixed(lookahead), timeout, forwards, async);
+}
+
+motion::MotionHandle motion::Chassis::follow(pathing::PathHandle path, const pathing::LookaheadPolicy& lookahead,
+                                             int timeout, bool forwards, bool async) {
+    if (!path.valid()) {
+        lemlib::infoSink()->error("Cannot follow path: handle is not from a registry. Skipping motion");
+        takeMarkers().finish(MotionResult::SKIPPED);
+        return MotionHandle::ended(MotionResult::SKIPPED);
+    }
+    const pathing::PathRegistry::Entry& entry = path.registry->entry(path);
+    if (!entry.loaded || entry.result != pathing::LoadResult::OK) {
+        lemlib::infoSink()->error("Cannot follow {}: {}. Skipping motion", entry.name,
+                                  entry.loaded ? pathing::toString(entry.result) : "registry not loaded");
+        takeMarkers().finish(MotionResult::SKIPPED);
+        return MotionHandle::ended(MotionResult::SKIPPED);
+    }
+    if (entry.kind == pathing::PathRegistry::Kind::TRAJECTORY) {
+        return follow(path.registry->trajectory(path), lookahead.maxLookahead, timeout, forwards, async);
+    }
+    return follow(path.registry->path(path), lookahead, timeout, forwards, async);
+}
+
+void motion::Chassis::purePursuit(pathing::PathView path, pathing::LookaheadPolicy lookahead, int timeout,
+                                  bool forwards, bool async, MarkerList markers, MotionHandle handle) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        // the view is captured by value, the caller's copy may be a temporary
+        pros::Task task([this, path, lookahead, timeout, forwards, markers, handle]() {
+            purePursuit(path, lookahead, timeout, forwards, false, markers, handle);
+        });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    pursue(path, lookahead, timeout, forwards, markers, handle);
+}
+
+void motion::Chassis::followCompressed(asset path, pathing::LookaheadPolicy lookahead, int timeout, bool forwards,
+                                       bool async, MarkerList markers, MotionHandle handle) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, path, lookahead, timeout, forwards, markers, handle]() {
+            followCompressed(path, lookahead, timeout, forwards, false, markers, handle);
+        });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    if (pathing::decodedSize(path) > sizeof(decodeBuffer)) {
+        lemlib::infoSink()->error("Cannot follow path: over {} points, use a PathRegistry. Skipping motion",
+                                  DECODE_CAPACITY);
+        markers.finish(MotionResult::SKIPPED);
+        handle.finish(MotionResult::SKIPPED);
+        distTraveled = -1;
+        this->endMotion();
+        return;
+    }
+    // no other motion can be using the buffer now
+    pathing::LoadResult result;
+    const pathing::PathView view = pathing::decode(path, decodeBuffer, sizeof(decodeBuffer), &result);
+    if (result != pathing::LoadResult::OK) {
+        lemlib::infoSink()->error("Cannot follow path: {}. Skipping motion", pathing::toString(result));
+        markers.finish(MotionResult::SKIPPED);
+        handle.finish(MotionResult::SKIPPED);
+        distTraveled = -1;
+        this->endMotion();
+        return;
+    }
+    pursue(view.transformed(fieldTransform), lookahead, timeout, forwards, markers, handle);
+}
+
+void motion::Chassis::pursue(pathing::PathView path, const pathing::LookaheadPolicy& lookahead, int timeout,
+                            bool forwards, MarkerList& markers, const MotionHandle& handle) {
+    if (path.empty()) {
+        lemlib::infoSink()->error("No points in path! Skipping motion");
+        markers.finish(MotionResult::SKIPPED);
+        handle.finish(MotionResult::SKIPPED);
+        distTraveled = -1;
+        this->endMotion();
+        return;
+    }
+
+    // no other motion can be using the buffer now
+    bool limited = pathSpeedLimits.enabled();
+    if (limited && path.size() > DECODE_CAPACITY) {
+        lemlib::infoSink()->warn("Path speed limits skipped: over {} points", DECODE_CAPACITY);
+        limited = false;
+    }
+    const float fullSpeed = wheelSpeed(drivetrain);
+    if (limited) pathing::limitSpeeds(path, pathSpeedLimits, fullSpeed, speedBuffer);
+    const uint32_t expected = expectedTime(pathDuration(path, limited ? speedBuffer : nullptr, fullSpeed), false);
+    timeout = timeoutParams.resolve(timeout, expected);
+    handle.start(expected);
+
+    pathing::PathCursor cursor(path);
+    lemlib::Pose pose = this->getPose(true);
+    lemlib::Pose lastPose = pose;
+    const int compState = pros::competition::get_status();
+    distTraveled = 0;
+    bool settled = false;
+
+    for (int i = 0; i < timeout / 10 && pros::competition::get_status() == compState && this->motionRunning; i++) {
+        pose = this->getPose(true);
+        if (!forwards) pose.theta -= M_PI;
+
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        const size_t closestPoint = cursor.update(pose.x, pose.y);
+        markers.update(distTraveled, closestPoint, path.size() > 1 ? float(closestPoint) / (path.size() - 1) : 1);
+        handle.update(distTraveled);
+        float targetVel = limited ? speedBuffer[closestPoint] : path[closestPoint].speed;
+        // a speed of 0 marks the end of the path
+        if (targetVel == 0) {
+            settled = true;
+            break;
+        }
+
+        // the curvature ahead is only worth searching for if it can change the lookahead
+        const float curvatureAhead =
+            lookahead.adaptive() ? cursor.curvatureAhead(lookahead.speedLookahead(targetVel)) : 0;
+        const float lookaheadDist = lookahead.lookahead(targetVel, curvatureAhead);
+        const pathing::Point lookaheadPoint = cursor.lookahead(pose.x, pose.y, lookaheadDist);
+        const lemlib::Pose lookaheadPose(lookaheadPoint.x, lookaheadPoint.y);
+
+        // with no intersection the last lookahead point is kept, and the robot can reach it
+        const float curvatureHeading = M_PI / 2 - pose.theta;
+        const float curvature =
+            pose.distance(lookaheadPose) < 0.01 ? 0 : findLookaheadCurvature(pose, curvatureHeading, lookaheadPose);
+
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // ratio the speeds to respect the max speed
+        const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+
+        if (forwards) {
+            drivetrain.leftMotors->move(targetLeftVel);
+            drivetrain.rightMotors->move(targetRightVel);
+        } else {
+            drivetrain.leftMotors->move(-targetRightVel);
+            drivetrain.rightMotors->move(-targetLeftVel);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    const MotionResult result = loopResult(settled, compState);
+    markers.finish(result);
+    handle.finish(result);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
+
+void motion::Chassis::trackTrajectory(pathing::TrajectoryView trajectory, float lookahead, int timeout, bool forwards,
+                                      bool async, MarkerList markers, MotionHandle handle) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, trajectory, lookahead, timeout, forwards, markers, handle]() {
+            trackTrajectory(trajectory, lookahead, timeout, forwards, false, markers, handle);
+        });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    if (trajectory.empty()) {
+        lemlib::infoSink()->error("No samples in trajectory! Skipping motion");
+        markers.finish(MotionResult::SKIPPED);
+        handle.finish(MotionResult::SKIPPED);
+        distTraveled = -1;
+        this->endMotion();
+        return;
+    }
+
+    // a trajectory ends on time
+    const uint32_t expected = expectedTime(trajectory.duration(), false);
+    timeout = timeoutParams.resolve(timeout, expected);
+    handle.start(expected);
+
+    size_t lookaheadIndex = 0;
+    lemlib::Pose pose = this->getPose(true);
+    lemlib::Pose lastPose = pose;
+    const int compState = pros::competition::get_status();
+    const uint32_t start = pros::millis();
+    distTraveled = 0;
+    bool settled = false;
+
+    for (int i = 0; i < timeout / 10 && pros::competition::get_status() == compState && this->motionRunning; i++) {
+        pose = this->getPose(true);
+        if (!forwards) pose.theta -= M_PI;
+
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        const float elapsed = (pros::millis() - start) / 1000.0f;
+        if (elapsed > trajectory.duration()) {
+            settled = true;
+            break;
+        }
+        const size_t index = trajectory.indexAt(elapsed);
+        markers.update(distTraveled, index, elapsed / trajectory.duration());
+        handle.update(distTraveled);
+        const pathing::TrajectorySample target = trajectory[index];
+
+        // the steering point is lookahead inches past the target, found by walking on from last tick's
+        lookaheadIndex = std::max(lookaheadIndex, index);
+        while (lookaheadIndex + 1 < trajectory.size()) {
+            const pathing::TrajectorySample sample = trajectory[lookaheadIndex];
+            if (std::hypot(sample.x - target.x, sample.y - target.y) >= lookahead) break;
+            lookaheadIndex++;
+        }
+        const pathing::TrajectorySample steer = trajectory[lookaheadIndex];
+        const lemlib::Pose lookaheadPose(steer.x, steer.y);
+
+        const float curvature = pose.distance(lookaheadPose) < 0.01
+                                    ? target.curvature
+                                    : findLookaheadCurvature(pose, M_PI / 2 - pose.theta, lookaheadPose);
+
+        // how much faster than the robot's center each side goes on this curvature
+        const float leftScale = (2 + curvature * drivetrain.trackWidth) / 2;
+        const float rightScale = (2 - curvature * drivetrain.trackWidth) / 2;
+        if (forwards) {
+            driveSides({target.velocity * leftScale, target.acceleration * leftScale},
+                       {target.velocity * rightScale, target.acceleration * rightScale}, 127);
+        } else {
+            // backwards, the robot's left side drives the trajectory's right
+            driveSides({-target.velocity * rightScale, -target.acceleration * rightScale},
+                       {-target.velocity * leftScale, -target.acceleration * leftScale}, 127);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    const MotionResult result = loopResult(settled, compState);
+    markers.finish(result);
+    handle.finish(result);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
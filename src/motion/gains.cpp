@@ -0,0 +1,79 @@
+#include <memory>
+#include "motion/chassis.hpp"
+
+void motion::Chassis::addGainSet(const std::string& name, GainSet gains, std::function<bool()> when) {
+    for (size_t i = 0; i < gainSets.size(); i++) {
+        if (gainSets[i].name != name) continue;
+        gainSets[i].gains = std::move(gains);
+        gainSets[i].when = std::move(when);
+        // the new gains go on with the next motion
+        if (activeGains == i) activeGains = SIZE_MAX;
+        return;
+    }
+    gainSets.push_back({name, std::move(gains), std::move(when)});
+}
+
+bool motion::Chassis::useGainSet(const std::string& name) {
+    for (size_t i = 0; i < gainSets.size(); i++) {
+        if (gainSets[i].name != name) continue;
+        chosenGains = i;
+        return true;
+    }
+    return false;
+}
+
+const std::string& motion::Chassis::getGainSet() const {
+    return gainSets[activeGains < gainSets.size() ? activeGains : chosenGains].name;
+}
+
+size_t motion::Chassis::pickGains() const {
+    for (size_t i = 0; i < gainSets.size(); i++) {
+        if (gainSets[i].when && gainSets[i].when()) return i;
+    }
+    return chosenGains;
+}
+
+void motion::Chassis::requestMotionStart() {
+    // a watcher checks its motion is still running and then cancels it, and LemLib's mutex can't be held across the
+    // two. Nothing may queue behind the motion until the watch ends, or the motion could end between the check and
+    // the cancel and hand the chassis over, and the cancel would stop this motion instead
+    const uint32_t cancels = cancelAllCount;
+    while (watchedGeneration != 0) {
+        // this motion would have been queued, and cancelAllMotions() drops queued motions
+        if (cancelAllCount != cancels) return;
+        pros::delay(5);
+    }
+    lemlib::Chassis::requestMotionStart();
+    if (!this->motionRunning) return;
+    motionGeneration++;
+    applyGains();
+}
+
+void motion::Chassis::applyGains() {
+    const size_t index = pickGains();
+    if (index == activeGains) return;
+    activeGains = index;
+    const GainSet& gains = gainSets[index].gains;
+    lateralSettings = gains.lateral;
+    angularSettings = gains.angular;
+    lateralSettle = gains.lateralSettle;
+    angularSettle = gains.angularSettle;
+    lateralProfile = gains.lateralProfile;
+    angularProfile = gains.angularProfile;
+    // LemLib's PIDs and exit conditions keep their gains const, so new gains mean new ones in their place. Every motion
+    // resets them when it starts, so nothing carries over
+    std::destroy_at(&lateralPID);
+    std::construct_at(&lateralPID, gains.lateral.kP, gains.lateral.kI, gains.lateral.kD, gains.lateral.windupRange,
+                      true);
+    std::destroy_at(&angularPID);
+    std::construct_at(&angularPID, gains.angular.kP, gains.angular.kI, gains.angular.kD, gains.angular.windupRange,
+                      false);
+    std::destroy_at(&lateralLargeExit);
+    std::construct_at(&lateralLargeExit, gains.lateral.largeError, int(gains.lateral.largeErrorTimeout));
+    std::destroy_at(&lateralSmallExit);
+    std::construct_at(&lateralSmallExit, gains.lateral.smallError, int(gains.lateral.smallErrorTimeout));
+    std::destroy_at(&angularLargeExit);
+    std::construct_at(&angularLargeExit, gains.angular.largeError, int(gains.angular.largeErrorTimeout));
+    std::destroy_at(&angularSmallExit);
+    std::construct_at(&angularSmallExit, gains.angular.smallError, int(gains.angular.smallErrorTimeout));
+}
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "motion/handle.hpp"
+
+namespace motion {
+struct MotionHandle::State {
+        struct Waiter {
+                pros::task_t task;
+                float distance; /** INFINITY to wait for the end of the motion */
+        };
+
+        pros::Mutex mutex;
+        float distance = 0;
+        MotionResult result = MotionResult::RUNNING;
+        bool started = false;
+        uint32_t startTime = 0; /** pros::millis() when the motion started */
+        uint32_t endTime = 0; /** pros::millis() when the motion ended */
+        uint32_t expected = 0; /** milliseconds, 0 if unknown */
+        /** tasks blocked on the handle. Each is notified once, by whichever call removes it */
+        std::vector<Waiter> waiters;
+};
+
+MotionHandle::MotionHandle()
+    : state(std::make_shared<State>()) {}
+
+MotionHandle MotionHandle::ended(MotionResult result) {
+    MotionHandle handle;
+    handle.finish(result);
+    return handle;
+}
+
+bool MotionHandle::wait(float distance, uint32_t timeout) const {
+    const pros::task_t self = pros::c::task_get_current();
+    {
+        std::lock_guard<pros::Mutex> lock(state->mutex);
+        if (state->result != MotionResult::RUNNING || state->distance >= distance) return true;
+        state->waiters.push_back({self, distance});
+    }
+
+    const uint32_t start = pros::millis();
+    while (true) {
+        const uint32_t elapsed = pros::millis() - start;
+        const uint32_t remaining =
+            timeout == TIMEOUT_MAX ? TIMEOUT_MAX : timeout - std::min(elapsed, timeout);
+        const bool notified = pros::Task::notify_take(true, remaining) > 0;
+        std::lock_guard<pros::Mutex> lock(state->mutex);
+        const auto waiter = std::find_if(state->waiters.begin(), state->waiters.end(),
+                                         [self](const State::Waiter& waiter) { return waiter.task == self; });
+        // removed from the list means woken by the motion, anything else was a stray notification
+        if (waiter == state->waiters.end()) {
+            // the notification was sent after the wait timed out, don't leave it for the next wait
+            if (!notified) pros::Task::notify_take(true, 0);
+            return true;
+        }
+        if (!notified && remaining == 0) {
+            state->waiters.erase(waiter);
+            return false;
+        }
+    }
+}
+
+bool MotionHandle::waitUntil(float distance, uint32_t timeout) const {
+    wait(distance, timeout);
+    return this->distance() >= distance;
+}
+
+MotionResult MotionHandle::waitUntilDone(uint32_t timeout) const {
+    wait(INFINITY, timeout);
+    return result();
+}
+
+MotionResult MotionHandle::result() const {
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    return state->result;
+}
+
+float MotionHandle::distance() const {
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    return state->distance;
+}
+
+uint32_t MotionHandle::expectedTime() const {
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    return state->expected;
+}
+
+uint32_t MotionHandle::elapsedTime() const {
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    if (!state->started) return 0;
+    return (state->result == MotionResult::RUNNING ? pros::millis() : state->endTime) - state->startTime;
+}
+
+void MotionHandle::start(uint32_t expected) const {
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    if (state->result != MotionResult::RUNNING) return;
+    state->started = true;
+    state->startTime = pros::millis();
+    state->expected = expected;
+}
+
+void MotionHandle::update(float distance) const {
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    if (state->result != MotionResult::RUNNING) return;
+    state->distance = distance;
+    auto reached = std::partition(state->waiters.begin(), state->waiters.end(),
+                                  [distance](const State::Waiter& waiter) { return waiter.distance > distance; });
+    for (auto waiter = reached; waiter != state->waiters.end(); waiter++) pros::c::task_notify(waiter->task);
+    state->waiters.erase(reached, state->waiters.end());
+}
+
+void MotionHandle::finish(MotionResult result) const {
+    std::lock_guard<pros::Mutex> lock(state->mutex);
+    if (state->result != MotionResult::RUNNING || result == MotionResult::RUNNING) return;
+    state->result = result;
+    state->endTime = pros::millis();
+    if (state->started) {
+        std::printf("motion,%u,%u,%s\n", unsigned(state->expected), unsigned(state->endTime - state->startTime),
+                    toString(result));
+    }
+    for (const State::Waiter& waiter : state->waiters) pros::c::task_notify(waiter.task);
+    state->waiters.clear();
+}
+
+const char* toString(MotionResult result) {
+    switch (result) {
+        case MotionResult::RUNNING: return "running";
+        case MotionResult::SETTLED: return "settled";
+        case MotionResult::TIMEOUT: return "timed out";
+        case MotionResult::CANCELLED: return "cancelled";
+        case MotionResult::INTERRUPTED: return "interrupted by a competition mode change";
+        case MotionResult::SKIPPED: return "skipped";
+    }
+    return "unknown";
+}
+} // namespace motion
@@ -0,0 +1,274 @@
+#include <cmath>
+#include "lemlib/chassis/odom.hpp"
+#include "pros/misc.hpp"
+#include "motion/chassis.hpp"
+
+void motion::Chassis::setLateralProfile(pathing::ProfileLimits limits) {
+    gainSets.front().gains.lateralProfile = limits;
+    if (activeGains == 0) lateralProfile = limits;
+}
+
+void motion::Chassis::setAngularProfile(pathing::ProfileLimits limits) {
+    gainSets.front().gains.angularProfile = limits;
+    if (activeGains == 0) angularProfile = limits;
+}
+
+bool motion::Chassis::profiled(const pathing::ProfileLimits& limits, float minSpeed, float earlyExitRange) {
+    return limits.maxVelocity > 0 && limits.maxAcceleration > 0 && minSpeed == 0 && earlyExitRange == 0;
+}
+
+float motion::Chassis::boomerangLength(const lemlib::Pose& start, float x, float y, float theta, float lead) {
+    const float distance = std::hypot(x - start.x, y - start.y);
+    const float carrotX = x - std::sin(theta) * lead * distance;
+    const float carrotY = y - std::cos(theta) * lead * distance;
+    float length = 0;
+    float lastX = start.x;
+    float lastY = start.y;
+    for (int i = 1; i <= 16; i++) {
+        const float t = i / 16.0f;
+        const float u = 1 - t;
+        const float curveX = u * u * start.x + 2 * u * t * carrotX + t * t * x;
+        const float curveY = u * u * start.y + 2 * u * t * carrotY + t * t * y;
+        length += std::hypot(curveX - lastX, curveY - lastY);
+        lastX = curveX;
+        lastY = curveY;
+    }
+    return length;
+}
+
+void motion::Chassis::profiledMove(float x, float y, float theta, float lead, int timeout, bool forwards,
+                                   float maxSpeed, bool async, MarkerList markers, MotionHandle handle) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, x, y, theta, lead, timeout, forwards, maxSpeed, markers, handle]() {
+            profiledMove(x, y, theta, lead, timeout, forwards, maxSpeed, false, markers, handle);
+        });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    const bool pose = !std::isnan(theta);
+    // backwards, the robot's heading is flipped each tick, so the target's is too
+    const float targetTheta = pose ? lemlib::degToRad(theta) + (forwards ? 0 : M_PI) : 0;
+    lemlib::Pose lastPose = this->getPose(true);
+    const float planned = pose ? boomerangLength(lastPose, x, y, targetTheta, lead)
+                               : std::hypot(x - lastPose.x, y - lastPose.y);
+
+    // inches per second at full power
+    const float fullSpeed = wheelSpeed(drivetrain);
+    pathing::ProfileLimits limits = lateralProfile;
+    limits.maxVelocity = std::fmin(limits.maxVelocity, fullSpeed * maxSpeed / 127);
+    const pathing::MotionProfile profile(planned, limits);
+    const uint32_t expected = expectedTime(profile.duration(), true);
+    timeout = timeoutParams.resolve(timeout, expected);
+    handle.start(expected);
+
+    lemlib::PID lateralPID(lateralSettings.kP, lateralSettings.kI, lateralSettings.kD, lateralSettings.windupRange,
+                           true);
+    lemlib::PID angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange,
+                           false);
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    SettleCondition settle = lateralSettle;
+    const int compState = pros::competition::get_status();
+    const uint32_t start = pros::millis();
+    distTraveled = 0;
+    bool settled = false;
+
+    while (pros::millis() - start < uint32_t(timeout) && pros::competition::get_status() == compState &&
+           this->motionRunning) {
+        lemlib::Pose robot = this->getPose(true);
+        distTraveled += robot.distance(lastPose);
+        lastPose = robot;
+        markers.update(distTraveled, 0, planned > 0 ? distTraveled / planned : 0);
+        handle.update(distTraveled);
+        if (!forwards) robot.theta += M_PI;
+
+        const float distance = std::hypot(x - robot.x, y - robot.y);
+        // a pose is driven to through the carrot point, which closes in on the target as the robot does
+        const float aimX = pose ? x - std::sin(targetTheta) * lead * distance : x;
+        const float aimY = pose ? y - std::cos(targetTheta) * lead * distance : y;
+        const float aimError = lemlib::angleError(std::atan2(aimX - robot.x, aimY - robot.y), robot.theta, true);
+
+        const float elapsed = (pros::millis() - start) / 1000.0f;
+        const pathing::ProfileState target = profile.sample(elapsed);
+        float lateral;
+        SideCommand left;
+        SideCommand right;
+        if (elapsed < profile.duration()) {
+            // feed the profile forward on each side, the PID only corrects how far the robot is behind the profile
+            const float alignment = std::fmax(std::cos(aimError), 0.0f);
+            left.velocity = (forwards ? target.velocity : -target.velocity) * alignment;
+            left.acceleration = (forwards ? target.acceleration : -target.acceleration) * alignment;
+            right.velocity = left.velocity;
+            right.acceleration = left.acceleration;
+            lateral = lateralPID.update(target.position - distTraveled) * alignment;
+        } else {
+            // the profile is done, settle on the target like LemLib's moveToPoint
+            const lemlib::Pose speed = lemlib::getSpeed(true);
+            if (exitMet(settle, lateralSmallExit, lateralLargeExit, distance, std::hypot(speed.x, speed.y))) {
+                settled = true;
+                break;
+            }
+            const float targetError = lemlib::angleError(std::atan2(x - robot.x, y - robot.y), robot.theta, true);
+            lateral = lateralPID.update(distance * std::cos(targetError));
+        }
+        lateral = std::fmin(std::fabs(lateral), maxSpeed) * lemlib::sgn(lateral);
+
+        // close to the target small position errors swing the heading around, so a point stops steering and a pose
+        // turns to its final heading
+        float angular = 0;
+        if (distance > 7.5) {
+            angular = angularPID.update(lemlib::radToDeg(aimError));
+        } else if (pose) {
+            angular = angularPID.update(lemlib::radToDeg(lemlib::angleError(targetTheta, robot.theta, true)));
+        }
+        angular = std::fmin(std::fabs(angular), maxSpeed) * lemlib::sgn(angular);
+
+        const float forwardOut = forwards ? lateral : -lateral;
+        left.correction = forwardOut + angular;
+        right.correction = forwardOut - angular;
+        driveSides(left, right, maxSpeed);
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    const MotionResult result = loopResult(settled, compState);
+    markers.finish(result);
+    handle.finish(result);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
+
+void motion::Chassis::profiledTurn(float x, float y, float theta, bool forwards, lemlib::AngularDirection direction,
+                                   bool swing, lemlib::DriveSide lockedSide, int timeout, float maxSpeed, bool async,
+                                   MarkerList markers, MotionHandle handle) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task(
+            [this, x, y, theta, forwards, direction, swing, lockedSide, timeout, maxSpeed, markers, handle]() {
+                profiledTurn(x, y, theta, forwards, direction, swing, lockedSide, timeout, maxSpeed, false, markers,
+                             handle);
+            });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // a swing moves the robot's center, so the heading to a point is worked out again each tick
+    const auto targetHeading = [x, y, theta, forwards](const lemlib::Pose& pose) {
+        if (!std::isnan(theta)) return theta;
+        return lemlib::radToDeg(std::atan2(x - pose.x, y - pose.y)) + (forwards ? 0 : 180);
+    };
+    lemlib::Pose pose = this->getPose();
+    const float angle = lemlib::angleError(targetHeading(pose), pose.theta, false, direction);
+
+    // a turn in place spins both wheels around the center, a swing spins the moving wheel around the locked one.
+    // Either way the turn is planned in wheel distance per degree, so the wheels are held to the same limits
+    const float wheelPerDegree = lemlib::degToRad(1) * (swing ? drivetrain.trackWidth : drivetrain.trackWidth / 2);
+    const float fullSpeed = wheelSpeed(drivetrain);
+    pathing::ProfileLimits limits = angularProfile;
+    if (swing) {
+        limits.maxVelocity /= 2;
+        limits.maxAcceleration /= 2;
+        limits.maxJerk /= 2;
+    }
+    limits.maxVelocity = std::fmin(limits.maxVelocity, fullSpeed * maxSpeed / 127 / wheelPerDegree);
+    const pathing::MotionProfile profile(angle, limits);
+    const uint32_t expected = expectedTime(profile.duration(), true);
+    timeout = timeoutParams.resolve(timeout, expected);
+    handle.start(expected);
+
+    // the locked side holds its position, LemLib's swings do the same
+    pros::MotorGroup* const locked =
+        lockedSide == lemlib::DriveSide::LEFT ? drivetrain.leftMotors : drivetrain.rightMotors;
+    const pros::MotorBrake lockedBrake = locked->get_brake_mode();
+    if (swing) {
+        locked->set_brake_mode_all(pros::MotorBrake::hold);
+        locked->brake();
+    }
+
+    lemlib::PID angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange,
+                           false);
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    SettleCondition settle = angularSettle;
+    const int compState = pros::competition::get_status();
+    const uint32_t start = pros::millis();
+    // degrees turned so far, towards the target
+    float turned = 0;
+    float lastTheta = pose.theta;
+    distTraveled = 0;
+    bool settled = false;
+
+    while (pros::millis() - start < uint32_t(timeout) && pros::competition::get_status() == compState &&
+           this->motionRunning) {
+        pose = this->getPose();
+        turned += lemlib::angleError(pose.theta, lastTheta, false);
+        lastTheta = pose.theta;
+        // LemLib's turns report the angle turned as the distance traveled
+        distTraveled = std::fabs(turned);
+        markers.update(distTraveled, 0, angle != 0 ? turned / angle : 0);
+        handle.update(distTraveled);
+
+        const float elapsed = (pros::millis() - start) / 1000.0f;
+        // the left wheel goes forwards for a clockwise turn, the right wheel backwards
+        SideCommand left;
+        SideCommand right;
+        float angular;
+        if (elapsed < profile.duration()) {
+            // feed the profile forward as wheel velocities, the PID only corrects how far the robot is behind the
+            // profile
+            const pathing::ProfileState state = profile.sample(elapsed);
+            left.velocity = state.velocity * wheelPerDegree;
+            left.acceleration = state.acceleration * wheelPerDegree;
+            right.velocity = -left.velocity;
+            right.acceleration = -left.acceleration;
+            angular = angularPID.update(state.position - turned);
+        } else {
+            // the profile is done, settle on the heading like LemLib's turns
+            const float error = lemlib::angleError(targetHeading(pose), pose.theta, false);
+            if (exitMet(settle, angularSmallExit, angularLargeExit, error, lemlib::getSpeed().theta)) {
+                settled = true;
+                break;
+            }
+            angular = angularPID.update(error);
+        }
+        angular = std::fmin(std::fabs(angular), maxSpeed) * lemlib::sgn(angular);
+        left.correction = angular;
+        right.correction = -angular;
+        left.hold = swing && lockedSide == lemlib::DriveSide::LEFT;
+        right.hold = swing && lockedSide == lemlib::DriveSide::RIGHT;
+        driveSides(left, right, maxSpeed);
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    if (swing) locked->set_brake_mode_all(lockedBrake);
+    const MotionResult result = loopResult(settled, compState);
+    markers.finish(result);
+    handle.finish(result);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
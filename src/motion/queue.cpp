@@ -0,0 +1,238 @@
+#include <cmath>
+#include "lemlib/chassis/odom.hpp"
+#include "pros/misc.hpp"
+#include "motion/chassis.hpp"
+
+void motion::Chassis::queueMoveToPoint(float x, float y, int timeout, QueueParams params) {
+    motionQueue.push_back({QueuedMotion::Type::POINT, pathing::transformX(fieldTransform, x),
+                           pathing::transformY(fieldTransform, y), 0, timeout, params});
+}
+
+void motion::Chassis::queueTurnToHeading(float theta, int timeout, QueueParams params) {
+    motionQueue.push_back(
+        {QueuedMotion::Type::HEADING, 0, 0, pathing::transformHeading(fieldTransform, theta), timeout, params});
+}
+
+/**
+ * @brief where a list of queued motions ends, with theta in degrees
+ */
+static lemlib::Pose queueEnd(const std::vector<motion::QueuedMotion>& motions, lemlib::Pose pose) {
+    for (const motion::QueuedMotion& motion : motions) {
+        if (motion.type == motion::QueuedMotion::Type::HEADING) {
+            pose.theta = motion.theta;
+            continue;
+        }
+        // a move ends facing the way it drove
+        pose.theta = lemlib::radToDeg(std::atan2(motion.x - pose.x, motion.y - pose.y)) +
+                     (motion.params.forwards ? 0 : 180);
+        pose.x = motion.x;
+        pose.y = motion.y;
+    }
+    return pose;
+}
+
+motion::MotionHandle motion::Chassis::runQueue(bool async) {
+    std::vector<QueuedMotion> motions;
+    motions.swap(motionQueue);
+    plannedEnd = queueEnd(motions, expectedStart());
+    MotionHandle handle;
+    runMotions(std::move(motions), async, takeMarkers(), handle);
+    return handle;
+}
+
+void motion::Chassis::clearQueue() { motionQueue.clear(); }
+
+/**
+ * @brief whether a motion can hand over to the next one without stopping
+ */
+static bool blends(const motion::QueuedMotion& motion, const motion::QueuedMotion& next) {
+    // a move into a turn has to stop, and so does reversing direction
+    if (motion.type == motion::QueuedMotion::Type::POINT) {
+        return next.type == motion::QueuedMotion::Type::POINT && next.params.forwards == motion.params.forwards;
+    }
+    return next.type == motion::QueuedMotion::Type::POINT;
+}
+
+/**
+ * @brief the power a move can still have when it hands over to the next move
+ *
+ * Full speed if the path goes straight on, down to 0 if it doubles back.
+ */
+static float cornerSpeed(const motion::QueuedMotion& motion, const motion::QueuedMotion& next, float startX,
+                         float startY) {
+    const float inX = motion.x - startX;
+    const float inY = motion.y - startY;
+    float outX = next.x - motion.x;
+    float outY = next.y - motion.y;
+    // a second move to the same point carries straight on
+    if (std::hypot(outX, outY) < 0.1) {
+        outX = inX;
+        outY = inY;
+    }
+    const float lengths = std::hypot(inX, inY) * std::hypot(outX, outY);
+    const float cosine = lengths < 0.01 ? 1 : (inX * outX + inY * outY) / lengths;
+    return std::fmin(motion.params.maxSpeed, next.params.maxSpeed) * (1 + cosine) / 2;
+}
+
+void motion::Chassis::runMotions(std::vector<QueuedMotion> motions, bool async, MarkerList markers,
+                                 MotionHandle handle) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, motions, markers, handle]() { runMotions(motions, false, markers, handle); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    lemlib::PID lateralPID(lateralSettings.kP, lateralSettings.kI, lateralSettings.kD, lateralSettings.windupRange,
+                           true);
+    lemlib::PID angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange,
+                           false);
+    // the lateral output is carried from one motion to the next, that's what keeps the handoff smooth
+    float lateralOut = 0;
+
+    lemlib::Pose lastPose = this->getPose(true);
+    float startX = lastPose.x;
+    float startY = lastPose.y;
+    const int compState = pros::competition::get_status();
+    distTraveled = 0;
+    // whether the last motion to run settled, rather than timing out. An empty queue has nothing to do
+    bool settled = motions.empty();
+
+    // straight line length of the whole queue, for FRACTION markers, and how long each motion should take
+    const DurationModel model = durationModel();
+    float planned = 0;
+    uint32_t expected = 0;
+    float plannedX = startX;
+    float plannedY = startY;
+    float plannedTheta = lemlib::radToDeg(lastPose.theta);
+    for (size_t k = 0; k < motions.size(); k++) {
+        QueuedMotion& motion = motions[k];
+        float seconds;
+        if (motion.type == QueuedMotion::Type::POINT) {
+            const float length = std::hypot(motion.x - plannedX, motion.y - plannedY);
+            seconds = model.move(length, motion.params.maxSpeed);
+            planned += length;
+            plannedTheta = lemlib::radToDeg(std::atan2(motion.x - plannedX, motion.y - plannedY)) +
+                           (motion.params.forwards ? 0 : 180);
+            plannedX = motion.x;
+            plannedY = motion.y;
+        } else {
+            seconds = model.turn(lemlib::angleError(motion.theta, plannedTheta, false), motion.params.maxSpeed);
+            plannedTheta = motion.theta;
+        }
+        // a motion that hands over to the next one doesn't settle
+        const bool settles = k + 1 == motions.size() || !blends(motion, motions[k + 1]);
+        const uint32_t motionExpected = expectedTime(seconds, settles);
+        motion.timeout = timeoutParams.resolve(motion.timeout, motionExpected);
+        expected += motionExpected;
+    }
+    handle.start(expected);
+
+    for (size_t k = 0; k < motions.size() && this->motionRunning; k++) {
+        const QueuedMotion& motion = motions[k];
+        const bool blend = k + 1 < motions.size() && blends(motion, motions[k + 1]);
+        const float exitSpeed =
+            blend && motion.type == QueuedMotion::Type::POINT ? cornerSpeed(motion, motions[k + 1], startX, startY)
+                                                              : 0;
+        lateralPID.reset();
+        angularPID.reset();
+        lateralLargeExit.reset();
+        lateralSmallExit.reset();
+        angularLargeExit.reset();
+        angularSmallExit.reset();
+        SettleCondition moveSettle = lateralSettle;
+        SettleCondition turnSettle = angularSettle;
+        const uint32_t start = pros::millis();
+        settled = false;
+
+        while (pros::millis() - start < uint32_t(motion.timeout) && pros::competition::get_status() == compState &&
+               this->motionRunning) {
+            lemlib::Pose pose = this->getPose(true);
+            const lemlib::Pose speed = lemlib::getSpeed(true);
+            distTraveled += pose.distance(lastPose);
+            lastPose = pose;
+            markers.update(distTraveled, k, planned > 0 ? distTraveled / planned : 0);
+            handle.update(distTraveled);
+            if (motion.type == QueuedMotion::Type::POINT && !motion.params.forwards) pose.theta += M_PI;
+
+            float lateral;
+            float angular;
+            if (motion.type == QueuedMotion::Type::POINT) {
+                const float distance = std::hypot(motion.x - pose.x, motion.y - pose.y);
+                const float headingError =
+                    lemlib::angleError(std::atan2(motion.x - pose.x, motion.y - pose.y), pose.theta, true);
+                if (blend) {
+                    // hand over at the blend radius, or once the robot has gone past the target
+                    const bool passed =
+                        (pose.x - motion.x) * (motion.x - startX) + (pose.y - motion.y) * (motion.y - startY) > 0;
+                    settled = distance < motion.params.blendRadius || passed;
+                    if (settled) break;
+                    // slow down towards the corner speed the same way the lateral PID slows towards a target
+                    lateral = exitSpeed + lateralSettings.kP * (distance - motion.params.blendRadius);
+                } else {
+                    settled = exitMet(moveSettle, lateralSmallExit, lateralLargeExit, distance,
+                                      std::hypot(speed.x, speed.y));
+                    if (settled) break;
+                    lateral = lateralPID.update(distance * std::cos(headingError));
+                }
+                lateral = std::fmin(std::fabs(lateral), motion.params.maxSpeed) * lemlib::sgn(lateral);
+                // turn towards the target before driving at it
+                if (blend) lateral *= std::fmax(std::cos(headingError), 0.0f);
+                // close to a final target small position errors swing the heading around, so stop steering
+                angular = !blend && distance < 7.5 ? 0 : angularPID.update(lemlib::radToDeg(headingError));
+            } else {
+                const float error = lemlib::angleError(motion.theta, lemlib::radToDeg(pose.theta), false);
+                settled = (blend && std::fabs(error) < motion.params.blendAngle) ||
+                          exitMet(turnSettle, angularSmallExit, angularLargeExit, error,
+                                  lemlib::radToDeg(speed.theta));
+                if (settled) break;
+                angular = angularPID.update(error);
+                lateral = 0;
+            }
+            angular = std::fmin(std::fabs(angular), motion.params.maxSpeed) * lemlib::sgn(angular);
+
+            // limit acceleration only, like LemLib's motions
+            if (lateralSettings.slew > 0 && std::fabs(lateral) > std::fabs(lateralOut)) {
+                lateralOut = lemlib::slew(lateral, lateralOut, lateralSettings.slew);
+            } else {
+                lateralOut = lateral;
+            }
+
+            // ratio the speeds to respect the max speed
+            const float forwardOut = motion.params.forwards ? lateralOut : -lateralOut;
+            float leftPower = forwardOut + angular;
+            float rightPower = forwardOut - angular;
+            const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / motion.params.maxSpeed;
+            if (ratio > 1) {
+                leftPower /= ratio;
+                rightPower /= ratio;
+            }
+            drivetrain.leftMotors->move(leftPower);
+            drivetrain.rightMotors->move(rightPower);
+
+            pros::delay(10);
+        }
+
+        if (motion.type == QueuedMotion::Type::POINT) {
+            startX = motion.x;
+            startY = motion.y;
+        }
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    const MotionResult result = loopResult(settled, compState);
+    markers.finish(result);
+    handle.finish(result);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,120 @@
+#include <cmath>
+#include "pros/misc.hpp"
+#include "motion/chassis.hpp"
+
+motion::MotionHandle motion::Chassis::ramsete(pathing::TrajectoryView trajectory, int timeout, RamseteParams params,
+                                              bool async) {
+    trajectory = trajectory.transformed(fieldTransform);
+    if (!trajectory.empty()) {
+        const pathing::TrajectorySample last = trajectory[trajectory.size() - 1];
+        plannedEnd = {last.x, last.y, last.heading + (params.forwards ? 0 : 180)};
+    }
+    MotionHandle handle;
+    ramseteTrack(trajectory, timeout, params, async, takeMarkers(), handle);
+    return handle;
+}
+
+motion::MotionHandle motion::Chassis::ramsete(pathing::PathHandle trajectory, int timeout, RamseteParams params,
+                                              bool async) {
+    if (!trajectory.valid()) {
+        lemlib::infoSink()->error("Cannot track trajectory: handle is not from a registry. Skipping motion");
+        takeMarkers().finish(MotionResult::SKIPPED);
+        return MotionHandle::ended(MotionResult::SKIPPED);
+    }
+    const pathing::PathRegistry::Entry& entry = trajectory.registry->entry(trajectory);
+    if (!entry.loaded || entry.result != pathing::LoadResult::OK) {
+        lemlib::infoSink()->error("Cannot track {}: {}. Skipping motion", entry.name,
+                                  entry.loaded ? pathing::toString(entry.result) : "registry not loaded");
+        takeMarkers().finish(MotionResult::SKIPPED);
+        return MotionHandle::ended(MotionResult::SKIPPED);
+    }
+    if (entry.kind != pathing::PathRegistry::Kind::TRAJECTORY) {
+        lemlib::infoSink()->error("Cannot track {}: it is a path, not a trajectory. Skipping motion", entry.name);
+        takeMarkers().finish(MotionResult::SKIPPED);
+        return MotionHandle::ended(MotionResult::SKIPPED);
+    }
+    return ramsete(trajectory.registry->trajectory(trajectory), timeout, params, async);
+}
+
+void motion::Chassis::ramseteTrack(pathing::TrajectoryView trajectory, int timeout, RamseteParams params, bool async,
+                                   MarkerList markers, MotionHandle handle) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) {
+        markers.finish(MotionResult::CANCELLED);
+        handle.finish(MotionResult::CANCELLED);
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, trajectory, timeout, params, markers, handle]() {
+            ramseteTrack(trajectory, timeout, params, false, markers, handle);
+        });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    if (trajectory.empty()) {
+        lemlib::infoSink()->error("No samples in trajectory! Skipping motion");
+        markers.finish(MotionResult::SKIPPED);
+        handle.finish(MotionResult::SKIPPED);
+        distTraveled = -1;
+        this->endMotion();
+        return;
+    }
+
+    // a trajectory ends on time
+    const uint32_t expected = expectedTime(trajectory.duration(), false);
+    timeout = timeoutParams.resolve(timeout, expected);
+    handle.start(expected);
+
+    const pathing::RamseteGains gains = {params.b, params.zeta};
+    lemlib::Pose lastPose = this->getPose(true);
+    const int compState = pros::competition::get_status();
+    const uint32_t start = pros::millis();
+    distTraveled = 0;
+    bool settled = false;
+
+    while (pros::millis() - start < uint32_t(timeout) && pros::competition::get_status() == compState &&
+           this->motionRunning) {
+        lemlib::Pose pose = this->getPose(true);
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+        // backwards, the back of the robot drives the trajectory
+        if (!params.forwards) pose.theta += M_PI;
+
+        const float elapsed = (pros::millis() - start) / 1000.0f;
+        if (elapsed > trajectory.duration()) {
+            settled = true;
+            break;
+        }
+        const size_t index = trajectory.indexAt(elapsed);
+        markers.update(distTraveled, index, elapsed / trajectory.duration());
+        handle.update(distTraveled);
+        const pathing::TrajectorySample target = trajectory[index];
+
+        const pathing::ChassisSpeeds speeds = pathing::ramsete(target, pose.x, pose.y, pose.theta, gains);
+        const float left = speeds.velocity + speeds.angular * drivetrain.trackWidth / 2;
+        const float right = speeds.velocity - speeds.angular * drivetrain.trackWidth / 2;
+        const pathing::WheelSpeeds acceleration = pathing::wheelAccelerations(trajectory, index, drivetrain.trackWidth);
+
+        if (params.forwards) {
+            driveSides({left, acceleration.left}, {right, acceleration.right}, 127);
+        } else {
+            // backwards, the robot's left side drives the trajectory's right
+            driveSides({-right, -acceleration.right}, {-left, -acceleration.left}, 127);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    const MotionResult result = loopResult(settled, compState);
+    markers.finish(result);
+    handle.finish(result);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
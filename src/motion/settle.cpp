@@ -0,0 +1,85 @@
+#include <cmath>
+#include "motion/settle.hpp"
+
+namespace motion {
+
+SettleCondition SettleCondition::test(Kind kind, float range, uint32_t time) {
+    SettleCondition condition;
+    condition.nodes.push_back({kind, range, time, 0, 0});
+    return condition;
+}
+
+SettleCondition SettleCondition::error(float range, uint32_t time) { return test(Kind::ERROR, range, time); }
+
+SettleCondition SettleCondition::velocity(float range, uint32_t time) { return test(Kind::VELOCITY, range, time); }
+
+SettleCondition SettleCondition::errorRate(float range, uint32_t time) { return test(Kind::ERROR_RATE, range, time); }
+
+SettleCondition SettleCondition::combine(Kind kind, const SettleCondition& other) const {
+    // a condition with no tests leaves the other one as it is
+    if (empty()) return other;
+    if (other.empty()) return *this;
+    SettleCondition combined;
+    combined.nodes = nodes;
+    const size_t offset = nodes.size();
+    for (Node node : other.nodes) {
+        node.left += offset;
+        node.right += offset;
+        combined.nodes.push_back(node);
+    }
+    combined.nodes.push_back({kind, 0, 0, offset - 1, combined.nodes.size() - 1});
+    combined.reset();
+    return combined;
+}
+
+SettleCondition SettleCondition::operator&(const SettleCondition& other) const { return combine(Kind::AND, other); }
+
+SettleCondition SettleCondition::operator|(const SettleCondition& other) const { return combine(Kind::OR, other); }
+
+void SettleCondition::reset() {
+    for (Node& node : nodes) node.holding = false;
+    done = false;
+    started = false;
+}
+
+bool SettleCondition::evaluate(size_t index, float error, float velocity, float rate, uint32_t time) {
+    Node& node = nodes[index];
+    float value = NAN;
+    switch (node.kind) {
+        case Kind::AND: {
+            // both sides are always evaluated, so every test's timer stays up to date
+            const bool left = evaluate(node.left, error, velocity, rate, time);
+            const bool right = evaluate(node.right, error, velocity, rate, time);
+            return left && right;
+        }
+        case Kind::OR: {
+            const bool left = evaluate(node.left, error, velocity, rate, time);
+            const bool right = evaluate(node.right, error, velocity, rate, time);
+            return left || right;
+        }
+        case Kind::ERROR: value = error; break;
+        case Kind::VELOCITY: value = velocity; break;
+        case Kind::ERROR_RATE: value = rate; break;
+    }
+    if (!(std::fabs(value) <= node.range)) {
+        node.holding = false;
+        return false;
+    }
+    if (!node.holding) {
+        node.holding = true;
+        node.since = time;
+    }
+    return time - node.since >= node.time;
+}
+
+bool SettleCondition::update(float error, float velocity, uint32_t time) {
+    if (done || empty()) return done;
+    // the rate is unknown until there are two updates, and a NaN fails every test on it
+    const float rate = started && time != lastTime ? (error - lastError) / (time - lastTime) * 1000 : NAN;
+    started = true;
+    lastError = error;
+    lastTime = time;
+    done = evaluate(nodes.size() - 1, error, velocity, rate, time);
+    return done;
+}
+} // namespace motion
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cmath>
+#include "motion/sysid.hpp"
+
+namespace motion {
+
+// samples either side used to measure acceleration, 50ms. The motors' velocity readings are too coarse and noisy for
+// neighbouring samples
+static constexpr size_t SLOPE_SPAN = 5;
+// slower than this a side counts as at rest, inches per second
+static constexpr float REST_VELOCITY = 0.5;
+
+float sysIdVoltage(SysIdTest test, float time, const SysIdParams& params) {
+    if (time < 0 || time >= sysIdDuration(test, params)) return 0;
+    switch (test) {
+        case SysIdTest::QUASISTATIC_FORWARD: return params.rampRate * time;
+        case SysIdTest::QUASISTATIC_BACKWARD: return -params.rampRate * time;
+        case SysIdTest::DYNAMIC_FORWARD: return params.stepVoltage;
+        case SysIdTest::DYNAMIC_BACKWARD: return -params.stepVoltage;
+    }
+    return 0;
+}
+
+float sysIdDuration(SysIdTest test, const SysIdParams& params) {
+    const bool quasistatic = test == SysIdTest::QUASISTATIC_FORWARD || test == SysIdTest::QUASISTATIC_BACKWARD;
+    return quasistatic ? params.quasistaticTime : params.dynamicTime;
+}
+
+namespace {
+// least squares fit of power = kS * sgn(v) + kV * v + kA * a, accumulated one sample at a time
+struct Regression {
+        double xx[3][3] = {};
+        double xy[3] = {};
+        double yy = 0;
+        double ySum = 0;
+        size_t count = 0;
+
+        void add(float velocity, float acceleration, float power) {
+            const double x[3] = {velocity > 0 ? 1.0 : -1.0, velocity, acceleration};
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) xx[i][j] += x[i] * x[j];
+                xy[i] += x[i] * power;
+            }
+            yy += double(power) * power;
+            ySum += power;
+            count++;
+        }
+
+        // solve the normal equations by Gaussian elimination, and work out how much of the variation is explained
+        Feedforward solve(float& r2) const {
+            double a[3][4];
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) a[i][j] = xx[i][j];
+                a[i][3] = xy[i];
+            }
+            for (int col = 0; col < 3; col++) {
+                int pivot = col;
+                for (int row = col + 1; row < 3; row++) {
+                    if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+                }
+                if (std::fabs(a[pivot][col]) < 1e-9) {
+                    r2 = 0;
+                    return {};
+                }
+                for (int j = 0; j < 4; j++) std::swap(a[col][j], a[pivot][j]);
+                for (int row = 0; row < 3; row++) {
+                    if (row == col) continue;
+                    const double factor = a[row][col] / a[col][col];
+                    for (int j = col; j < 4; j++) a[row][j] -= factor * a[col][j];
+                }
+            }
+            const double k[3] = {a[0][3] / a[0][0], a[1][3] / a[1][1], a[2][3] / a[2][2]};
+            // residual sum of squares from the normal equations: y'y - 2k'X'y + k'X'Xk
+            double residual = yy;
+            for (int i = 0; i < 3; i++) {
+                residual -= 2 * k[i] * xy[i];
+                for (int j = 0; j < 3; j++) residual += k[i] * xx[i][j] * k[j];
+            }
+            const double total = yy - ySum * ySum / count;
+            r2 = total > 0 ? float(1 - residual / total) : 0;
+            return {float(k[0]), float(k[1]), float(k[2])};
+        }
+};
+} // namespace
+
+SysIdFit fitFeedforward(const std::vector<SysIdSample>& samples) {
+    Regression left;
+    Regression right;
+    float maxAcceleration = 0;
+
+    // a test starts where time goes backwards
+    size_t testEnd;
+    for (size_t testStart = 0; testStart < samples.size(); testStart = testEnd) {
+        testEnd = testStart + 1;
+        while (testEnd < samples.size() && samples[testEnd].time >= samples[testEnd - 1].time) testEnd++;
+
+        for (size_t i = testStart + SLOPE_SPAN; i + SLOPE_SPAN < testEnd; i++) {
+            const SysIdSample& before = samples[i - SLOPE_SPAN];
+            const SysIdSample& after = samples[i + SLOPE_SPAN];
+            const float dt = after.time - before.time;
+            if (dt <= 0) continue;
+            const float leftAcceleration = (after.leftVelocity - before.leftVelocity) / dt;
+            const float rightAcceleration = (after.rightVelocity - before.rightVelocity) / dt;
+            // velocity averaged over the same samples, noise near rest would otherwise flip the sign of kS
+            float leftVelocity = 0;
+            float rightVelocity = 0;
+            for (size_t j = i - SLOPE_SPAN; j <= i + SLOPE_SPAN; j++) {
+                leftVelocity += samples[j].leftVelocity / (2 * SLOPE_SPAN + 1);
+                rightVelocity += samples[j].rightVelocity / (2 * SLOPE_SPAN + 1);
+            }
+            const float power = samples[i].voltage / 12 * 127;
+
+            if (std::fabs(leftVelocity) > REST_VELOCITY) {
+                left.add(leftVelocity, leftAcceleration, power);
+                maxAcceleration = std::fmax(maxAcceleration, std::fabs(leftAcceleration));
+            }
+            if (std::fabs(rightVelocity) > REST_VELOCITY) {
+                right.add(rightVelocity, rightAcceleration, power);
+                maxAcceleration = std::fmax(maxAcceleration, std::fabs(rightAcceleration));
+            }
+        }
+    }
+
+    SysIdFit fit;
+    fit.samples = std::max(left.count, right.count);
+    if (left.count < 3 || right.count < 3) return fit;
+    fit.left = left.solve(fit.leftR2);
+    fit.right = right.solve(fit.rightR2);
+    if (fit.left.kV > 0 && fit.right.kV > 0) {
+        fit.maxVelocity = std::fmin((127 - fit.left.kS) / fit.left.kV, (127 - fit.right.kS) / fit.right.kV);
+    }
+    fit.maxAcceleration = maxAcceleration;
+    return fit;
+}
+} // namespace motion
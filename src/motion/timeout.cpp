@@ -0,0 +1,34 @@
+#include <algorithm>
+#include <cmath>
+#include "motion/timeout.hpp"
+#include "path/profile.hpp"
+
+namespace motion {
+int TimeoutParams::resolve(int timeout, uint32_t expected) const {
+    if (timeout != AUTO_TIMEOUT) return timeout;
+    if (expected == 0) return int(maximum);
+    return int(std::clamp(uint32_t(std::lround(expected * margin)), minimum, maximum));
+}
+
+DurationModel::DurationModel(Feedforward feedforward, float trackWidth)
+    : feedforward(feedforward),
+      trackWidth(trackWidth) {}
+
+float DurationModel::move(float distance, float power) const {
+    const float usable = std::fabs(power) - feedforward.kS;
+    if (usable <= 0 || feedforward.kV <= 0 || distance == 0) return 0;
+    // with no kA the wheels get up to speed straight away
+    const float acceleration = feedforward.kA > 0 ? usable / feedforward.kA : INFINITY;
+    const float velocity = usable / feedforward.kV;
+    if (std::isinf(acceleration)) return std::fabs(distance) / velocity;
+    return pathing::MotionProfile(distance, {velocity, acceleration}).duration();
+}
+
+float DurationModel::turn(float degrees, float power) const {
+    return move(degrees * float(M_PI) / 180 * trackWidth / 2, power);
+}
+
+float DurationModel::swing(float degrees, float power) const {
+    return move(degrees * float(M_PI) / 180 * trackWidth, power);
+}
+} // namespace motion
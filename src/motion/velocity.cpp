@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cmath>
+#include "motion/chassis.hpp"
+
+void motion::Chassis::setVelocityControl(VelocityControl mode, float kP) {
+    velocityControl = mode;
+    velocityKP = kP;
+}
+
+/**
+ * @brief track a wheel velocity on one side with a cascaded velocity loop
+ *
+ * @param rpmPerInch motor rpm per inch per second of wheel velocity
+ */
+static void trackVelocity(pros::MotorGroup* motors, const motion::Feedforward& gains, float velocity,
+                          float acceleration, motion::VelocityControl mode, float kP, float rpmPerInch) {
+    if (mode == motion::VelocityControl::MOTOR) {
+        motors->move_velocity(std::lround(velocity * rpmPerInch));
+        return;
+    }
+    // average the motors that answer, an unplugged one reads PROS_ERR_F
+    float measured = 0;
+    int count = 0;
+    for (int i = 0; i < motors->size(); i++) {
+        const double rpm = motors->get_actual_velocity(i);
+        if (std::isinf(rpm)) continue;
+        measured += rpm;
+        count++;
+    }
+    const float feedback = count > 0 ? kP * (velocity - measured / count / rpmPerInch) : 0;
+    motors->move(std::clamp(gains.power(velocity, acceleration) + feedback, -127.0f, 127.0f));
+}
+
+void motion::Chassis::driveSides(const SideCommand& left, const SideCommand& right, float maxSpeed) {
+    const Feedforward leftGains = sideFeedforward(lemlib::DriveSide::LEFT);
+    const Feedforward rightGains = sideFeedforward(lemlib::DriveSide::RIGHT);
+    const float fullSpeed = wheelSpeed(drivetrain);
+    const float leftRpmPerInch = cartridgeRpm(drivetrain.leftMotors->get_gearing()) / fullSpeed;
+    const float rightRpmPerInch = cartridgeRpm(drivetrain.rightMotors->get_gearing()) / fullSpeed;
+
+    // a velocity loop needs to know how fast the motors go, so without that fall back on voltage
+    if (velocityControl == VelocityControl::VOLTAGE || leftRpmPerInch == 0 || rightRpmPerInch == 0) {
+        float leftPower = left.hold ? 0 : leftGains.power(left.velocity, left.acceleration) + left.correction;
+        float rightPower = right.hold ? 0 : rightGains.power(right.velocity, right.acceleration) + right.correction;
+        // ratio the speeds to respect the max speed
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+        if (left.hold) {
+            drivetrain.leftMotors->brake();
+        } else {
+            drivetrain.leftMotors->move(leftPower);
+        }
+        if (right.hold) {
+            drivetrain.rightMotors->brake();
+        } else {
+            drivetrain.rightMotors->move(rightPower);
+        }
+        return;
+    }
+
+    // the feedback becomes the wheel velocity that much more power would hold
+    float leftVelocity = left.hold ? 0 : left.velocity + left.correction / leftGains.kV;
+    float rightVelocity = right.hold ? 0 : right.velocity + right.correction / rightGains.kV;
+    float leftAcceleration = left.hold ? 0 : left.acceleration;
+    float rightAcceleration = right.hold ? 0 : right.acceleration;
+    // ratio the speeds to respect the max speed
+    const float topSpeed = fullSpeed * maxSpeed / 127;
+    const float ratio = std::max(std::fabs(leftVelocity), std::fabs(rightVelocity)) / topSpeed;
+    if (ratio > 1) {
+        leftVelocity /= ratio;
+        rightVelocity /= ratio;
+        leftAcceleration /= ratio;
+        rightAcceleration /= ratio;
+    }
+    if (left.hold) {
+        drivetrain.leftMotors->brake();
+    } else {
+        trackVelocity(drivetrain.leftMotors, leftGains, leftVelocity, leftAcceleration, velocityControl, velocityKP,
+                      leftRpmPerInch);
+    }
+    if (right.hold) {
+        drivetrain.rightMotors->brake();
+    } else {
+        trackVelocity(drivetrain.rightMotors, rightGains, rightVelocity, rightAcceleration, velocityControl,
+                      velocityKP, rightRpmPerInch);
+    }
+}
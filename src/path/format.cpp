@@ -0,0 +1,118 @@
+#include <cmath>
+#include <cstring>
+#include "path/format.hpp"
+
+namespace pathing {
+
+const char* toString(LoadResult result) {
+    switch (result) {
+        case LoadResult::OK: return "ok";
+        case LoadResult::NOT_BINARY: return "not a binary path";
+        case LoadResult::BAD_VERSION: return "unsupported path version";
+        case LoadResult::TRUNCATED: return "truncated path";
+        case LoadResult::BAD_CHECKSUM: return "checksum mismatch";
+        case LoadResult::COMPRESSED: return "compressed path";
+        case LoadResult::BUFFER_TOO_SMALL: return "buffer too small";
+        case LoadResult::NO_POINTS: return "no points in text path";
+    }
+    return "unknown";
+}
+
+uint32_t checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool isBinary(const asset& path) {
+    return path.size >= sizeof(Header) && std::memcmp(path.buf, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool isCompressed(const asset& path) {
+    if (!isBinary(path)) return false;
+    Header header;
+    std::memcpy(&header, path.buf, sizeof(Header));
+    return header.flags & FLAG_COMPRESSED;
+}
+
+LoadResult validate(const asset& path, Header* header) {
+    if (!isBinary(path)) return LoadResult::NOT_BINARY;
+
+    Header h;
+    std::memcpy(&h, path.buf, sizeof(Header));
+    if (h.version != VERSION || (h.flags & ~(FLAG_HEADING | FLAG_COMPRESSED)) != 0) return LoadResult::BAD_VERSION;
+
+    // a compressed stream runs to the end of the asset, whether it's long enough is only known once it is decoded
+    const size_t dataSize =
+        h.flags & FLAG_COMPRESSED ? path.size - sizeof(Header) : size_t(h.count) * pointSize(h.flags);
+    if (path.size < sizeof(Header) + dataSize) return LoadResult::TRUNCATED;
+    if (checksum(path.buf + sizeof(Header), dataSize) != h.checksum) return LoadResult::BAD_CHECKSUM;
+
+    if (header != nullptr) *header = h;
+    return LoadResult::OK;
+}
+
+static void writeVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+static uint32_t zigzag(int32_t value) { return (uint32_t(value) << 1) ^ uint32_t(value >> 31); }
+
+static int32_t quantize(float value) { return int32_t(std::lround(value * QUANTUM)); }
+
+// the compressed point stream described at FLAG_COMPRESSED
+static std::vector<uint8_t> compressPoints(const std::vector<Point>& points, const std::vector<float>& headings) {
+    std::vector<uint8_t> out;
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t speed = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        const int32_t qx = quantize(points[i].x);
+        const int32_t qy = quantize(points[i].y);
+        const int32_t qspeed = quantize(points[i].speed);
+        writeVarint(out, zigzag(qx - x));
+        writeVarint(out, zigzag(qy - y));
+        writeVarint(out, zigzag(qspeed - speed));
+        x = qx;
+        y = qy;
+        speed = qspeed;
+        if (!headings.empty()) writeVarint(out, std::isnan(headings[i]) ? 0 : zigzag(quantize(headings[i])) + 1);
+    }
+    return out;
+}
+
+std::vector<uint8_t> encode(const std::vector<Point>& points, const std::vector<float>& headings, bool compress) {
+    const uint16_t flags = (headings.empty() ? 0 : FLAG_HEADING) | (compress ? FLAG_COMPRESSED : 0);
+    std::vector<uint8_t> data;
+    if (compress) {
+        data = compressPoints(points, headings);
+    } else {
+        const size_t stride = pointSize(flags);
+        data.resize(points.size() * stride);
+        for (size_t i = 0; i < points.size(); i++) {
+            uint8_t* point = data.data() + i * stride;
+            std::memcpy(point, &points[i], sizeof(Point));
+            if (flags & FLAG_HEADING) std::memcpy(point + sizeof(Point), &headings[i], sizeof(float));
+        }
+    }
+
+    Header h;
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.flags = flags;
+    h.count = points.size();
+    h.checksum = checksum(data.data(), data.size());
+
+    std::vector<uint8_t> out(sizeof(Header) + data.size());
+    std::memcpy(out.data(), &h, sizeof(Header));
+    if (!data.empty()) std::memcpy(out.data() + sizeof(Header), data.data(), data.size());
+    return out;
+}
+} // namespace pathing
@@ -0,0 +1,138 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "path/parser.hpp"
+
+namespace pathing {
+
+static constexpr char POINTS_HEADER[] = "#PATH-POINTS-START";
+static constexpr char END_DATA[] = "endData";
+
+static bool startsWith(const char* begin, const char* end, const char* prefix, size_t length) {
+    return size_t(end - begin) >= length && std::memcmp(begin, prefix, length) == 0;
+}
+
+static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+static const char* skipSpaces(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) cursor++;
+    return cursor;
+}
+
+/**
+ * @brief parse a decimal number without needing a null terminator
+ *
+ * @return pointer to the character after the number, or nullptr if there is no number at cursor
+ */
+static const char* parseNumber(const char* cursor, const char* end, float& out) {
+    static constexpr double POWERS[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int MAX_DIGITS = 19; // fits in 64 bits, and well past float precision
+
+    bool negative = false;
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) negative = *cursor++ == '-';
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+    for (; cursor < end && isDigit(*cursor); cursor++) {
+        any = true;
+        if (digits < MAX_DIGITS) {
+            mantissa = mantissa * 10 + (*cursor - '0');
+            if (mantissa != 0) digits++;
+        } else {
+            exponent++;
+        }
+    }
+    if (cursor < end && *cursor == '.') {
+        for (cursor++; cursor < end && isDigit(*cursor); cursor++) {
+            any = true;
+            if (digits < MAX_DIGITS) {
+                mantissa = mantissa * 10 + (*cursor - '0');
+                if (mantissa != 0) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!any) return nullptr;
+
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        const char* digit = cursor + 1;
+        bool negativeExponent = false;
+        if (digit < end && (*digit == '-' || *digit == '+')) negativeExponent = *digit++ == '-';
+        if (digit < end && isDigit(*digit)) {
+            int value = 0;
+            for (; digit < end && isDigit(*digit); digit++) {
+                if (value < 1000) value = value * 10 + (*digit - '0');
+            }
+            exponent += negativeExponent ? -value : value;
+            cursor = digit;
+        }
+    }
+
+    double value = double(mantissa);
+    const int magnitude = exponent < 0 ? -exponent : exponent;
+    const double scale = magnitude <= 22 ? POWERS[magnitude] : std::pow(10.0, magnitude);
+    value = exponent < 0 ? value / scale : value * scale;
+    out = float(negative ? -value : value);
+    return cursor;
+}
+
+/**
+ * @brief parse "x, y, speed[, heading]". Fields may be separated by a comma, spaces, or both
+ */
+static bool parseRow(const char* cursor, const char* end, TextPoint& point) {
+    float* fields[] = {&point.x, &point.y, &point.speed, &point.heading};
+    point.heading = std::numeric_limits<float>::quiet_NaN();
+    for (size_t i = 0; i < 4; i++) {
+        if (i > 0) {
+            const char* next = skipSpaces(cursor, end);
+            // the heading column is optional
+            if (i == 3 && next == end) return true;
+            if (next < end && *next == ',') next = skipSpaces(next + 1, end);
+            else if (next == cursor) return false; // no separator
+            cursor = next;
+        }
+        cursor = parseNumber(cursor, end, *fields[i]);
+        if (cursor == nullptr) return false;
+    }
+    return skipSpaces(cursor, end) == end;
+}
+
+TextParser::TextParser(const char* begin, const char* end)
+    : cursor(begin),
+      end(end) {}
+
+TextParser::Status TextParser::next(TextPoint& point) {
+    while (!done && cursor < end) {
+        const char* line = cursor;
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        if (lineEnd == nullptr) lineEnd = end;
+        cursor = lineEnd == end ? end : lineEnd + 1;
+        lineNumber++;
+
+        if (lineEnd > line && lineEnd[-1] == '\r') lineEnd--;
+        line = skipSpaces(line, lineEnd);
+        if (line == lineEnd) continue;
+
+        if (*line == '#') {
+            // the JerryIO header may only come before the points
+            if (!started && startsWith(line, lineEnd, POINTS_HEADER, sizeof(POINTS_HEADER) - 1)) {
+                detected = TextFormat::JERRYIO_V01;
+                started = true;
+                continue;
+            }
+            // any other directive ends the points, this is where the JSON trailer starts
+            break;
+        }
+        if (startsWith(line, lineEnd, END_DATA, sizeof(END_DATA) - 1)) break;
+
+        started = true;
+        return parseRow(line, lineEnd, point) ? Status::POINT : Status::MALFORMED;
+    }
+    done = true;
+    return Status::END;
+}
+} // namespace pathing
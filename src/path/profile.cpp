@@ -0,0 +1,83 @@
+#include <cmath>
+#include "path/profile.hpp"
+
+namespace pathing {
+
+namespace {
+// shape of the ramp from rest up to a velocity
+struct Ramp {
+        float peakAcceleration;
+        float jerkTime;
+        float time;
+
+        float distance(float velocity) const { return velocity * time / 2; }
+};
+} // namespace
+
+static Ramp rampShape(float velocity, float acceleration, float jerk) {
+    if (jerk <= 0) return {acceleration, 0, velocity / acceleration};
+    // slow enough to never reach the acceleration limit, the acceleration is a triangle
+    if (velocity * jerk < acceleration * acceleration) {
+        const float peak = std::sqrt(velocity * jerk);
+        return {peak, peak / jerk, 2 * peak / jerk};
+    }
+    return {acceleration, acceleration / jerk, velocity / acceleration + acceleration / jerk};
+}
+
+MotionProfile::MotionProfile(float distance, const ProfileLimits& limits)
+    : sign(distance < 0 ? -1 : 1),
+      length(std::fabs(distance)),
+      jerk(limits.maxJerk > 0 ? limits.maxJerk : 0) {
+    float velocity = limits.maxVelocity;
+    Ramp shape = rampShape(velocity, limits.maxAcceleration, jerk);
+    if (2 * shape.distance(velocity) > length) {
+        // too short to reach the velocity limit, find the velocity whose ramps cover the whole move
+        float low = 0;
+        float high = velocity;
+        for (int i = 0; i < 32; i++) {
+            velocity = (low + high) / 2;
+            shape = rampShape(velocity, limits.maxAcceleration, jerk);
+            (2 * shape.distance(velocity) > length ? high : low) = velocity;
+        }
+        velocity = low;
+        shape = rampShape(velocity, limits.maxAcceleration, jerk);
+    }
+    peak = velocity;
+    peakAcceleration = shape.peakAcceleration;
+    jerkTime = shape.jerkTime;
+    rampTime = shape.time;
+    cruiseTime = peak > 0 ? (length - 2 * shape.distance(peak)) / peak : 0;
+}
+
+ProfileState MotionProfile::ramp(float t) const {
+    // velocity and position at the end of the first jerk phase
+    const float jerkVelocity = peakAcceleration * jerkTime / 2;
+    const float jerkPosition = jerk * jerkTime * jerkTime * jerkTime / 6;
+    if (t < jerkTime) return {jerk * t * t * t / 6, jerk * t * t / 2, jerk * t};
+    if (t < rampTime - jerkTime) {
+        const float u = t - jerkTime;
+        return {jerkPosition + jerkVelocity * u + peakAcceleration * u * u / 2, jerkVelocity + peakAcceleration * u,
+                peakAcceleration};
+    }
+    // the last jerk phase, measured back from the end of the ramp
+    const float u = rampTime - t;
+    return {peak * rampTime / 2 - (peak * u - jerk * u * u * u / 6), peak - jerk * u * u / 2, jerk * u};
+}
+
+ProfileState MotionProfile::sample(float t) const {
+    ProfileState state;
+    if (t <= 0) {
+        state = {0, 0, 0};
+    } else if (t < rampTime) {
+        state = ramp(t);
+    } else if (t < rampTime + cruiseTime) {
+        state = {peak * rampTime / 2 + peak * (t - rampTime), peak, 0};
+    } else if (t < duration()) {
+        const ProfileState mirrored = ramp(duration() - t);
+        state = {length - mirrored.position, mirrored.velocity, -mirrored.acceleration};
+    } else {
+        state = {length, 0, 0};
+    }
+    return {sign * state.position, sign * state.velocity, sign * state.acceleration};
+}
+} // namespace pathing
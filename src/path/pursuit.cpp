@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "path/pursuit.hpp"
+
+namespace pathing {
+
+static float distance(const Point& point, float x, float y) { return std::hypot(point.x - x, point.y - y); }
+
+// the point arc inches along the path from point start, or the last point if the path is shorter
+static Point pointAlong(const PathView& path, size_t start, float arc) {
+    for (size_t i = start; i + 1 < path.size(); i++) {
+        const Point p1 = path[i];
+        const Point p2 = path[i + 1];
+        const float length = distance(p2, p1.x, p1.y);
+        if (length > 0 && arc <= length) {
+            const float t = arc / length;
+            return {p1.x + (p2.x - p1.x) * t, p1.y + (p2.y - p1.y) * t, p1.speed};
+        }
+        arc -= length;
+    }
+    return path[path.size() - 1];
+}
+
+static size_t linearClosest(const PathView& path, float x, float y) {
+    size_t closest = 0;
+    float closestDist = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < path.size(); i++) {
+        const float dist = distance(path[i], x, y);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+int SegmentGrid::cellIndex(float x, float y) const {
+    const int cx = std::clamp(int((x - minX) / cellWidth), 0, CELLS - 1);
+    const int cy = std::clamp(int((y - minY) / cellHeight), 0, CELLS - 1);
+    return cy * CELLS + cx;
+}
+
+void SegmentGrid::build(const PathView& path) {
+    full = true;
+    if (path.size() < 2) return;
+
+    float maxX = -std::numeric_limits<float>::infinity();
+    float maxY = -std::numeric_limits<float>::infinity();
+    minX = std::numeric_limits<float>::infinity();
+    minY = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < path.size(); i++) {
+        const Point point = path[i];
+        minX = std::min(minX, point.x);
+        minY = std::min(minY, point.y);
+        maxX = std::max(maxX, point.x);
+        maxY = std::max(maxY, point.y);
+    }
+    cellWidth = std::max((maxX - minX) / CELLS, 1e-3f);
+    cellHeight = std::max((maxY - minY) / CELLS, 1e-3f);
+
+    // count the segments in each cell, then lay the cells out back to back
+    std::array<uint16_t, CELLS * CELLS + 1> counts {};
+    size_t total = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i + 1 < path.size(); i++) {
+            const Point a = path[i];
+            const Point b = path[i + 1];
+            const int first = cellIndex(std::min(a.x, b.x), std::min(a.y, b.y));
+            const int last = cellIndex(std::max(a.x, b.x), std::max(a.y, b.y));
+            for (int cy = first / CELLS; cy <= last / CELLS; cy++) {
+                for (int cx = first % CELLS; cx <= last % CELLS; cx++) {
+                    const int cell = cy * CELLS + cx;
+                    if (pass == 0) {
+                        counts[cell]++;
+                        if (++total > CAPACITY || i > UINT16_MAX) return;
+                    } else {
+                        segments[offsets[cell] + counts[cell]++] = i;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            offsets[0] = 0;
+            for (int cell = 0; cell < CELLS * CELLS; cell++) offsets[cell + 1] = offsets[cell] + counts[cell];
+            counts.fill(0);
+        }
+    }
+    full = false;
+}
+
+size_t SegmentGrid::closest(const PathView& path, float x, float y) const {
+    if (full) return linearClosest(path, x, y);
+
+    const int cell = cellIndex(x, y);
+    const int cx = cell % CELLS;
+    const int cy = cell / CELLS;
+    const float cellSize = std::min(cellWidth, cellHeight);
+    size_t closest = 0;
+    float closestDist = std::numeric_limits<float>::infinity();
+
+    // search rings of cells around the robot until no unsearched cell can hold a closer point
+    for (int ring = 0; ring < CELLS; ring++) {
+        if (closestDist <= (ring - 1) * cellSize) break;
+        for (int gy = std::max(cy - ring, 0); gy <= std::min(cy + ring, CELLS - 1); gy++) {
+            for (int gx = std::max(cx - ring, 0); gx <= std::min(cx + ring, CELLS - 1); gx++) {
+                // only the outline of the ring is new
+                if (std::abs(gx - cx) != ring && std::abs(gy - cy) != ring) continue;
+                const int searched = gy * CELLS + gx;
+                for (uint16_t entry = offsets[searched]; entry < offsets[searched + 1]; entry++) {
+                    const size_t segment = segments[entry];
+                    for (size_t i = segment; i <= segment + 1; i++) {
+                        const float dist = distance(path[i], x, y);
+                        if (dist < closestDist || (dist == closestDist && i < closest)) {
+                            closestDist = dist;
+                            closest = i;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return closest;
+}
+
+float circleIntersect(const Point& p1, const Point& p2, float x, float y, float radius) {
+    const float dx = p2.x - p1.x;
+    const float dy = p2.y - p1.y;
+    const float fx = p1.x - x;
+    const float fy = p1.y - y;
+    const float a = dx * dx + dy * dy;
+    const float b = 2 * (fx * dx + fy * dy);
+    const float c = (fx * fx + fy * fy) - radius * radius;
+    float discriminant = b * b - 4 * a * c;
+
+    if (discriminant >= 0 && a > 0) {
+        discriminant = std::sqrt(discriminant);
+        const float t1 = (-b - discriminant) / (2 * a);
+        const float t2 = (-b + discriminant) / (2 * a);
+        // prioritize further down the path
+        if (t2 >= 0 && t2 <= 1) return t2;
+        if (t1 >= 0 && t1 <= 1) return t1;
+    }
+    return -1;
+}
+
+float LookaheadPolicy::speedLookahead(float speed) const {
+    if (!adaptive()) return maxLookahead;
+    const float fraction = fullSpeed > 0 ? std::min(std::fabs(speed) / fullSpeed, 1.0f) : 1;
+    return minLookahead + (maxLookahead - minLookahead) * fraction;
+}
+
+float LookaheadPolicy::lookahead(float speed, float curvature) const {
+    if (!adaptive()) return maxLookahead;
+    return std::clamp(speedLookahead(speed) / (1 + curvatureGain * std::fabs(curvature)), minLookahead, maxLookahead);
+}
+
+float threePointCurvature(const Point& a, const Point& b, const Point& c) {
+    const float sides = distance(a, b.x, b.y) * distance(b, c.x, c.y) * distance(c, a.x, a.y);
+    if (sides == 0) return 0;
+    // twice the triangle's area over the product of its sides
+    const float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    return 2 * std::fabs(cross) / sides;
+}
+
+PathCursor::PathCursor(PathView path, size_t window, float recoveryDistance)
+    : path(path),
+      window(window),
+      recoveryDistance(recoveryDistance) {
+    if (!path.empty()) lastLookahead = path.front();
+    grid.build(path);
+}
+
+size_t PathCursor::update(float x, float y) {
+    if (path.empty()) return 0;
+
+    const size_t end = std::min(path.size(), index + window + 1);
+    size_t best = index;
+    float bestDist = distance(path[index], x, y);
+    for (size_t i = index + 1; i < end; i++) {
+        const float dist = distance(path[i], x, y);
+        // ties go to the point further along, or the speed 0 copy JerryIO puts on the last point is never reached
+        if (dist <= bestDist) {
+            bestDist = dist;
+            best = i;
+        }
+    }
+
+    // the robot is nowhere near where it was, find it again
+    if (bestDist > recoveryDistance) {
+        const size_t found = grid.closest(path, x, y);
+        if (distance(path[found], x, y) < bestDist) {
+            best = found;
+            lookaheadIndex = found;
+            lastLookahead = path[found];
+        }
+    }
+
+    index = best;
+    return index;
+}
+
+Point PathCursor::lookahead(float x, float y, float lookaheadDist) {
+    const size_t start = std::max(index, lookaheadIndex);
+    if (start + 1 >= path.size()) return lastLookahead;
+
+    // a point further along the path than this can't be lookaheadDist away from the robot
+    const float maxArc = lookaheadDist + distance(path[start], x, y);
+    float arc = 0;
+    for (size_t i = start; i + 1 < path.size() && arc <= maxArc; i++) {
+        const Point p1 = path[i];
+        const Point p2 = path[i + 1];
+        const float t = circleIntersect(p1, p2, x, y, lookaheadDist);
+        if (t != -1) {
+            lookaheadIndex = i;
+            lastLookahead = {p1.x + (p2.x - p1.x) * t, p1.y + (p2.y - p1.y) * t, p1.speed};
+            return lastLookahead;
+        }
+        arc += std::hypot(p2.x - p1.x, p2.y - p1.y);
+    }
+    // robot deviated from the path, keep the last lookahead point
+    return lastLookahead;
+}
+
+float PathCursor::curvatureAhead(float distance) const {
+    if (path.empty()) return 0;
+    return threePointCurvature(path[index], pointAlong(path, index, distance / 2), pointAlong(path, index, distance));
+}
+} // namespace pathing
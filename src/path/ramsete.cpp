@@ -0,0 +1,36 @@
+#include <cmath>
+#include "path/ramsete.hpp"
+
+namespace pathing {
+
+ChassisSpeeds ramsete(const TrajectorySample& target, float x, float y, float heading, const RamseteGains& gains) {
+    // the usual formulation has angles counterclockwise and y to the left, so the error is worked out in that frame
+    const float dx = target.x - x;
+    const float dy = target.y - y;
+    const float forwardError = dx * std::sin(heading) + dy * std::cos(heading);
+    const float leftError = dy * std::sin(heading) - dx * std::cos(heading);
+    const float headingError = std::remainder(heading - target.heading * float(M_PI) / 180, 2 * float(M_PI));
+
+    const float velocity = target.velocity;
+    const float angular = -target.velocity * target.curvature;
+    const float k = 2 * gains.zeta * std::sqrt(angular * angular + gains.b * velocity * velocity);
+    const float sinc = std::fabs(headingError) < 1e-4f ? 1 : std::sin(headingError) / headingError;
+
+    ChassisSpeeds speeds;
+    speeds.velocity = velocity * std::cos(headingError) + k * forwardError;
+    // back to clockwise
+    speeds.angular = -(angular + k * headingError + gains.b * velocity * sinc * leftError);
+    return speeds;
+}
+
+WheelSpeeds wheelAccelerations(const TrajectoryView& trajectory, size_t index, float trackWidth) {
+    if (index + 1 >= trajectory.size() || trajectory.timeStep() <= 0) return {0, 0};
+    const TrajectorySample now = trajectory[index];
+    const TrajectorySample next = trajectory[index + 1];
+    auto side = [&](const TrajectorySample& sample, float sign) {
+        return sample.velocity * (2 + sign * sample.curvature * trackWidth) / 2;
+    };
+    return {(side(next, 1) - side(now, 1)) / trajectory.timeStep(),
+            (side(next, -1) - side(now, -1)) / trajectory.timeStep()};
+}
+} // namespace pathing
@@ -0,0 +1,106 @@
+#include <cmath>
+#include "path/parser.hpp"
+#include "path/registry.hpp"
+
+namespace pathing {
+
+static TextParser textParser(const asset& source) {
+    const char* begin = reinterpret_cast<const char*>(source.buf);
+    return TextParser(begin, begin + source.size);
+}
+
+// validate an asset and work out how much of the arena it needs, without writing anything
+static void measure(PathRegistry::Entry& entry) {
+    if (isTrajectory(entry.source)) {
+        entry.kind = PathRegistry::Kind::TRAJECTORY;
+        entry.trajectory = TrajectoryView::fromAsset(entry.source, &entry.result);
+        entry.count = entry.trajectory.size();
+    } else if (isBinary(entry.source)) {
+        Header header;
+        entry.result = validate(entry.source, &header);
+        entry.count = header.count;
+        entry.stride = pointSize(header.flags);
+        if (header.flags & FLAG_COMPRESSED) entry.arenaBytes = entry.count * entry.stride;
+    } else {
+        TextParser parser = textParser(entry.source);
+        TextPoint point;
+        TextParser::Status status;
+        bool headings = false;
+        while ((status = parser.next(point)) != TextParser::Status::END) {
+            if (status != TextParser::Status::POINT) continue;
+            entry.count++;
+            headings |= !std::isnan(point.heading);
+        }
+        entry.result = entry.count == 0 ? LoadResult::NO_POINTS : LoadResult::OK;
+        entry.stride = headings ? pointSize(FLAG_HEADING) : sizeof(Point);
+        entry.arenaBytes = entry.count * entry.stride;
+    }
+    if (entry.result != LoadResult::OK) entry.arenaBytes = 0;
+}
+
+// write the decoded or parsed points of an asset into its part of the arena
+static void fill(PathRegistry::Entry& entry, uint8_t* out) {
+    if (isBinary(entry.source)) {
+        decode(entry.source, out, entry.arenaBytes, &entry.result);
+        return;
+    }
+    TextParser parser = textParser(entry.source);
+    TextPoint text;
+    TextParser::Status status;
+    while ((status = parser.next(text)) != TextParser::Status::END) {
+        if (status != TextParser::Status::POINT) continue;
+        const Point point = {text.x, text.y, text.speed};
+        std::memcpy(out, &point, sizeof(Point));
+        if (entry.stride > sizeof(Point)) std::memcpy(out + sizeof(Point), &text.heading, sizeof(float));
+        out += entry.stride;
+    }
+}
+
+PathHandle PathRegistry::add(const char* name, const asset& source) {
+    Entry entry;
+    entry.name = name;
+    entry.source = source;
+    entries.push_back(entry);
+    return {this, uint16_t(entries.size() - 1)};
+}
+
+size_t PathRegistry::load(uint64_t (*micros)()) {
+    auto now = [micros]() -> uint64_t { return micros != nullptr ? micros() : 0; };
+
+    // size everything first so the arena is allocated once
+    size_t arenaEnd = arena.size();
+    for (Entry& entry : entries) {
+        if (entry.loaded) continue;
+        const uint64_t start = now();
+        measure(entry);
+        entry.offset = arenaEnd;
+        arenaEnd += entry.arenaBytes;
+        entry.loadMicros = now() - start;
+    }
+    arena.resize(arenaEnd);
+
+    size_t failed = 0;
+    for (Entry& entry : entries) {
+        if (entry.loaded) continue;
+        const uint64_t start = now();
+        if (entry.arenaBytes > 0) fill(entry, arena.data() + entry.offset);
+        entry.loadMicros += now() - start;
+        entry.loaded = true;
+        if (entry.result != LoadResult::OK) failed++;
+    }
+    return failed;
+}
+
+PathView PathRegistry::path(PathHandle handle) const {
+    const Entry& e = entries[handle.index];
+    if (!e.loaded || e.result != LoadResult::OK || e.kind != Kind::PATH) return PathView();
+    const uint8_t* data = e.arenaBytes > 0 ? arena.data() + e.offset : e.source.buf + sizeof(Header);
+    return PathView(data, e.count, e.stride);
+}
+
+TrajectoryView PathRegistry::trajectory(PathHandle handle) const {
+    const Entry& e = entries[handle.index];
+    if (!e.loaded || e.result != LoadResult::OK || e.kind != Kind::TRAJECTORY) return TrajectoryView();
+    return e.trajectory;
+}
+} // namespace pathing
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "path/resample.hpp"
+
+namespace pathing {
+
+namespace {
+struct Sample {
+        Point point;
+        float heading;
+        bool keep; /** must be in the output */
+};
+} // namespace
+
+// Catmull-Rom knot spacing for centripetal parameterization, which can't form cusps or loops
+static float knotInterval(const Point& a, const Point& b) {
+    return std::max(std::sqrt(std::hypot(b.x - a.x, b.y - a.y)), 1e-4f);
+}
+
+// point at t in [0, 1] between p1 and p2 on the centripetal Catmull-Rom spline through p0..p3 (Barry-Goldman)
+static Point catmullRom(const Point& p0, const Point& p1, const Point& p2, const Point& p3, float t) {
+    const float t0 = 0;
+    const float t1 = t0 + knotInterval(p0, p1);
+    const float t2 = t1 + knotInterval(p1, p2);
+    const float t3 = t2 + knotInterval(p2, p3);
+    const float u = t1 + (t2 - t1) * t;
+
+    auto lerp = [u](const Point& a, const Point& b, float ta, float tb) -> Point {
+        const float f = (u - ta) / (tb - ta);
+        return {a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f, 0};
+    };
+    const Point a1 = lerp(p0, p1, t0, t1);
+    const Point a2 = lerp(p1, p2, t1, t2);
+    const Point a3 = lerp(p2, p3, t2, t3);
+    const Point b1 = lerp(a1, a2, t0, t2);
+    const Point b2 = lerp(a2, a3, t1, t3);
+    return lerp(b1, b2, t1, t2);
+}
+
+// distance from p to the segment ab, and how far along the segment the closest point is
+static float segmentDistance(const Point& p, const Point& a, const Point& b, float& along) {
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float lengthSquared = dx * dx + dy * dy;
+    along = lengthSquared == 0 ? 0 : std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared, 0.0f, 1.0f);
+    return std::hypot(p.x - (a.x + dx * along), p.y - (a.y + dy * along));
+}
+
+void resample(const std::vector<Point>& points, const std::vector<float>& headings, const ResampleSettings& settings,
+              std::vector<Point>& outPoints, std::vector<float>& outHeadings) {
+    const size_t n = points.size();
+    const bool hasHeadings = !headings.empty();
+    outPoints.clear();
+    outHeadings.clear();
+    if (n < 3 || settings.tolerance <= 0) {
+        outPoints = points;
+        outHeadings = headings;
+        return;
+    }
+
+    // dense samples along the spline, every original point is one of them
+    std::vector<Sample> dense;
+    for (size_t i = 0; i < n; i++) {
+        const float heading = hasHeadings ? headings[i] : std::numeric_limits<float>::quiet_NaN();
+        const bool stops = points[i].speed == 0 && (i == 0 || points[i - 1].speed != 0);
+        dense.push_back({points[i], heading, i == 0 || i == n - 1 || !std::isnan(heading) || stops});
+        if (i + 1 == n) break;
+
+        const Point& p1 = points[i];
+        const Point& p2 = points[i + 1];
+        const float length = std::hypot(p2.x - p1.x, p2.y - p1.y);
+        if (length < 1e-4f) continue;
+        // reflect the end points so the spline has a neighbour on both sides
+        const Point p0 = i > 0 ? points[i - 1] : Point {2 * p1.x - p2.x, 2 * p1.y - p2.y, 0};
+        const Point p3 = i + 2 < n ? points[i + 2] : Point {2 * p2.x - p1.x, 2 * p2.y - p1.y, 0};
+        const int steps = int(std::ceil(length / settings.sampleSpacing));
+        for (int step = 1; step < steps; step++) {
+            const float t = float(step) / steps;
+            Point p = catmullRom(p0, p1, p2, p3, t);
+            p.speed = p1.speed + (p2.speed - p1.speed) * t;
+            dense.push_back({p, std::numeric_limits<float>::quiet_NaN(), false});
+        }
+    }
+
+    // whether the segment from sample a to sample c represents every sample in between
+    auto fits = [&](size_t a, size_t c) {
+        const Point& start = dense[a].point;
+        const Point& end = dense[c].point;
+        if (std::hypot(end.x - start.x, end.y - start.y) > settings.maxSpacing) return false;
+        for (size_t j = a + 1; j < c; j++) {
+            float along;
+            if (segmentDistance(dense[j].point, start, end, along) > settings.tolerance) return false;
+            const float speed = start.speed + (end.speed - start.speed) * along;
+            if (std::fabs(dense[j].point.speed - speed) > settings.speedTolerance) return false;
+        }
+        return true;
+    };
+
+    // greedily make each segment as long as it can be
+    size_t a = 0;
+    outPoints.push_back(dense[0].point);
+    if (hasHeadings) outHeadings.push_back(dense[0].heading);
+    while (a + 1 < dense.size()) {
+        size_t best = a + 1;
+        for (size_t c = a + 2; c < dense.size() && !dense[c - 1].keep && fits(a, c); c++) best = c;
+        outPoints.push_back(dense[best].point);
+        if (hasHeadings) outHeadings.push_back(dense[best].heading);
+        a = best;
+    }
+}
+} // namespace pathing
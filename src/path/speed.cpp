@@ -0,0 +1,29 @@
+#include <algorithm>
+#include <cmath>
+#include "path/pursuit.hpp"
+#include "path/speed.hpp"
+
+namespace pathing {
+
+void limitSpeeds(const PathView& path, const SpeedLimits& limits, float fullSpeed, float* speeds) {
+    for (size_t i = 0; i < path.size(); i++) speeds[i] = path[i].speed;
+    if (path.size() < 2 || fullSpeed <= 0) return;
+    // limits are in inches per second, path speeds in motor power
+    const float toPower = 127 / fullSpeed;
+
+    for (size_t i = 1; i + 1 < path.size(); i++) {
+        speeds[i] = std::min(speeds[i], limits.turnSpeed(threePointCurvature(path[i - 1], path[i], path[i + 1]),
+                                                         fullSpeed));
+    }
+
+    if (!std::isfinite(limits.maxDeceleration)) return;
+    // v^2 = u^2 + 2as, from each point back to the one before it
+    for (size_t i = path.size() - 1; i-- > 0;) {
+        const Point a = path[i];
+        const Point b = path[i + 1];
+        const float next = speeds[i + 1] / toPower;
+        const float reachable = std::sqrt(next * next + 2 * limits.maxDeceleration * std::hypot(b.x - a.x, b.y - a.y));
+        speeds[i] = std::min(speeds[i], reachable * toPower);
+    }
+}
+} // namespace pathing
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include "path/trajectory.hpp"
+
+namespace pathing {
+
+// spacing of the dense samples the velocity passes run over, inches
+static constexpr float SAMPLE_SPACING = 0.25;
+
+namespace {
+struct Knot {
+        float x;
+        float y;
+        float s; /** distance along the path */
+        float heading; /** radians */
+        float curvature;
+        float velocity;
+        float time;
+};
+} // namespace
+
+static Vec2 evaluate(const Cubic& c, float t) {
+    const float u = 1 - t;
+    const float b0 = u * u * u;
+    const float b1 = 3 * u * u * t;
+    const float b2 = 3 * u * t * t;
+    const float b3 = t * t * t;
+    return {b0 * c[0].x + b1 * c[1].x + b2 * c[2].x + b3 * c[3].x,
+            b0 * c[0].y + b1 * c[1].y + b2 * c[2].y + b3 * c[3].y};
+}
+
+static float wrap(float angle) { return std::remainder(angle, float(2 * M_PI)); }
+
+static float toDegrees(float heading) {
+    const float degrees = std::fmod(heading * float(180 / M_PI), 360.0f);
+    return degrees < 0 ? degrees + 360 : degrees;
+}
+
+std::vector<TrajectorySample> generateTrajectory(const std::vector<Cubic>& segments, const TrajectoryLimits& limits,
+                                                 float dt) {
+    if (limits.speedLimit <= 0 || limits.maxVelocity <= 0 || limits.maxAcceleration <= 0 || dt <= 0) return {};
+
+    // sample the curve densely
+    std::vector<Knot> knots;
+    for (const Cubic& segment : segments) {
+        float polygon = 0;
+        for (size_t i = 0; i < 3; i++) {
+            polygon += std::hypot(segment[i + 1].x - segment[i].x, segment[i + 1].y - segment[i].y);
+        }
+        const int steps = std::max(8, int(std::ceil(polygon / SAMPLE_SPACING)));
+        for (int i = 0; i <= steps; i++) {
+            const Vec2 p = evaluate(segment, float(i) / steps);
+            if (!knots.empty()) {
+                const float ds = std::hypot(p.x - knots.back().x, p.y - knots.back().y);
+                if (ds < 1e-4f) continue;
+                knots.push_back({p.x, p.y, knots.back().s + ds, 0, 0, 0, 0});
+            } else {
+                knots.push_back({p.x, p.y, 0, 0, 0, 0, 0});
+            }
+        }
+    }
+    const size_t n = knots.size();
+    if (n < 2) return {};
+
+    // heading and curvature from central differences, so the joins between segments are handled like any other point
+    for (size_t i = 0; i < n; i++) {
+        const Knot& a = knots[i == 0 ? 0 : i - 1];
+        const Knot& b = knots[i + 1 == n ? n - 1 : i + 1];
+        knots[i].heading = std::atan2(b.x - a.x, b.y - a.y);
+    }
+    for (size_t i = 0; i < n; i++) {
+        const Knot& a = knots[i == 0 ? 0 : i - 1];
+        const Knot& b = knots[i + 1 == n ? n - 1 : i + 1];
+        knots[i].curvature = wrap(b.heading - a.heading) / (b.s - a.s);
+    }
+
+    // speed caps: the path speed limit, and the outside wheel can't go faster than the top wheel speed
+    const float cruise = limits.maxVelocity * std::min(limits.speedLimit, 1.0f);
+    for (Knot& knot : knots) {
+        knot.velocity =
+            std::min(cruise, limits.maxVelocity / (1 + std::fabs(knot.curvature) * limits.trackWidth / 2));
+    }
+    knots.front().velocity = 0;
+    knots.back().velocity = 0;
+
+    // forward pass for acceleration, backward pass for deceleration
+    for (size_t i = 1; i < n; i++) {
+        const float ds = knots[i].s - knots[i - 1].s;
+        const float previous = knots[i - 1].velocity;
+        const float reachable = std::sqrt(previous * previous + 2 * limits.maxAcceleration * ds);
+        knots[i].velocity = std::min(knots[i].velocity, reachable);
+    }
+    for (size_t i = n - 1; i-- > 0;) {
+        const float ds = knots[i + 1].s - knots[i].s;
+        const float next = knots[i + 1].velocity;
+        const float stoppable = std::sqrt(next * next + 2 * limits.maxAcceleration * ds);
+        knots[i].velocity = std::min({knots[i].velocity, stoppable, next + limits.decelerationRate * ds});
+    }
+
+    // time at each knot, assuming constant acceleration between knots
+    for (size_t i = 1; i < n; i++) {
+        const float ds = knots[i].s - knots[i - 1].s;
+        knots[i].time = knots[i - 1].time + 2 * ds / std::max(knots[i - 1].velocity + knots[i].velocity, 1e-6f);
+    }
+
+    // resample at the fixed time step
+    const float duration = knots.back().time;
+    const size_t count = size_t(std::ceil(duration / dt)) + 1;
+    std::vector<TrajectorySample> samples;
+    samples.reserve(count);
+    size_t i = 0;
+    for (size_t k = 0; k < count; k++) {
+        const float t = std::min(k * dt, duration);
+        while (i + 2 < n && knots[i + 1].time <= t) i++;
+        const Knot& a = knots[i];
+        const Knot& b = knots[i + 1];
+        const float ds = b.s - a.s;
+        const float accel = (b.velocity * b.velocity - a.velocity * a.velocity) / (2 * ds);
+        const float tau = std::clamp(t - a.time, 0.0f, b.time - a.time);
+        const float f = std::clamp((a.velocity * tau + accel * tau * tau / 2) / ds, 0.0f, 1.0f);
+        const float heading = a.heading + wrap(b.heading - a.heading) * f;
+        samples.push_back({a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f, toDegrees(heading),
+                           std::max(a.velocity + accel * tau, 0.0f), accel,
+                           a.curvature + (b.curvature - a.curvature) * f});
+    }
+    samples.back().velocity = 0;
+    samples.back().acceleration = 0;
+    return samples;
+}
+
+std::vector<uint8_t> encodeTrajectory(const std::vector<TrajectorySample>& samples, float dt) {
+    const size_t dataSize = sizeof(float) + samples.size() * sizeof(TrajectorySample);
+
+    std::vector<uint8_t> out(sizeof(Header) + dataSize);
+    uint8_t* data = out.data() + sizeof(Header);
+    std::memcpy(data, &dt, sizeof(float));
+    if (!samples.empty()) {
+        std::memcpy(data + sizeof(float), samples.data(), samples.size() * sizeof(TrajectorySample));
+    }
+
+    Header h;
+    std::memcpy(h.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+    h.version = TRAJECTORY_VERSION;
+    h.flags = 0;
+    h.count = samples.size();
+    h.checksum = checksum(data, dataSize);
+    std::memcpy(out.data(), &h, sizeof(Header));
+    return out;
+}
+
+bool isTrajectory(const asset& trajectory) {
+    return trajectory.size >= sizeof(Header) &&
+           std::memcmp(trajectory.buf, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC)) == 0;
+}
+
+TrajectoryView TrajectoryView::fromAsset(const asset& trajectory, LoadResult* result) {
+    LoadResult status = LoadResult::OK;
+    Header h;
+    float dt = 0;
+    if (!isTrajectory(trajectory)) {
+        status = LoadResult::NOT_BINARY;
+    } else {
+        std::memcpy(&h, trajectory.buf, sizeof(Header));
+        const size_t dataSize = sizeof(float) + size_t(h.count) * sizeof(TrajectorySample);
+        if (h.version != TRAJECTORY_VERSION || h.flags != 0) status = LoadResult::BAD_VERSION;
+        else if (trajectory.size < sizeof(Header) + dataSize) status = LoadResult::TRUNCATED;
+        else if (checksum(trajectory.buf + sizeof(Header), dataSize) != h.checksum) status = LoadResult::BAD_CHECKSUM;
+        else std::memcpy(&dt, trajectory.buf + sizeof(Header), sizeof(float));
+    }
+
+    if (result != nullptr) *result = status;
+    if (status != LoadResult::OK) return TrajectoryView();
+    return TrajectoryView(trajectory.buf + sizeof(Header) + sizeof(float), h.count, dt);
+}
+} // namespace pathing
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cmath>
+#include "path/view.hpp"
+
+namespace pathing {
+
+PathView PathView::fromAsset(const asset& path, LoadResult* result) {
+    Header header;
+    LoadResult status = validate(path, &header);
+    if (status == LoadResult::OK && header.flags & FLAG_COMPRESSED) status = LoadResult::COMPRESSED;
+    if (result != nullptr) *result = status;
+    if (status != LoadResult::OK) return PathView();
+    return PathView(path.buf + sizeof(Header), header.count, pointSize(header.flags));
+}
+
+PathView PathView::transformed(FieldTransform other) const {
+    PathView view = *this;
+    for (size_t p = 0; p < pieceCount; p++) {
+        Piece& piece = view.pieces[p];
+        piece.transform = compose(piece.transform, other);
+        // the rotation is applied after the field transform, so a mirror turns it the other way
+        if (mirrorsHandedness(other)) {
+            piece.degrees = -piece.degrees;
+            piece.sin = -piece.sin;
+        }
+        piece.dx = transformX(other, piece.dx);
+        piece.dy = transformY(other, piece.dy);
+    }
+    return view;
+}
+
+size_t PathView::firstStop() const {
+    size_t index = 0;
+    for (size_t p = 0; p < pieceCount; p++) {
+        for (size_t i = 0; i < pieces[p].count; i++, index++) {
+            if (index > 0 && pieces[p].point(i).speed == 0) return index;
+        }
+    }
+    return count;
+}
+
+PathView PathView::slice(size_t begin, size_t end) const {
+    end = std::min(end, count);
+    PathView view;
+    size_t start = 0;
+    for (size_t p = 0; p < pieceCount && start < end; p++) {
+        const Piece& piece = pieces[p];
+        // the part of [begin, end) in this piece, in the piece's own indices
+        const size_t a = begin > start ? begin - start : 0;
+        const size_t b = std::min(end - start, piece.count);
+        start += piece.count;
+        if (a >= b) continue;
+
+        Piece part = piece;
+        const size_t first = piece.reversed ? piece.count - b : a;
+        part.data += first * piece.stride;
+        part.count = b - a;
+        if (first > 0) part.firstSpeed = NAN;
+        if (first + part.count < piece.count) part.lastSpeed = NAN;
+        view.pieces[view.pieceCount++] = part;
+        view.count += part.count;
+    }
+    return view;
+}
+
+PathView PathView::reversed() const {
+    const size_t stop = firstStop();
+    const PathView kept = slice(0, stop < count ? stop + 1 : count);
+    PathView view = kept;
+    for (size_t p = 0; p < kept.pieceCount; p++) {
+        view.pieces[p] = kept.pieces[kept.pieceCount - 1 - p];
+        view.pieces[p].reversed = !view.pieces[p].reversed;
+    }
+    // the new first point was the end of the original, take the speed it was reached at
+    if (kept.count > 1) {
+        const float speed = kept[kept.count - 2].speed;
+        Piece& piece = view.pieces[0];
+        if (piece.reversed || piece.count == 1) piece.lastSpeed = speed;
+        if (!piece.reversed || piece.count == 1) piece.firstSpeed = speed;
+    }
+    return view;
+}
+
+PathView PathView::concatenated(const PathView& next) const {
+    PathView view = slice(0, firstStop());
+    if (view.pieceCount + next.pieceCount > MAX_PIECES) return PathView();
+    for (size_t p = 0; p < next.pieceCount; p++) view.pieces[view.pieceCount++] = next.pieces[p];
+    view.count += next.count;
+    return view;
+}
+
+PathView PathView::offset(float dx, float dy, float degrees) const {
+    if (empty()) return *this;
+    const Point origin = front();
+    const float radians = degrees * float(M_PI / 180);
+    const float cos = std::cos(radians);
+    const float sin = std::sin(radians);
+    PathView view = *this;
+    for (size_t p = 0; p < pieceCount; p++) {
+        Piece& piece = view.pieces[p];
+        // rotate the piece's existing rotation and offset about the origin, then move it
+        const float ox = piece.dx - origin.x;
+        const float oy = piece.dy - origin.y;
+        piece.dx = ox * cos + oy * sin + origin.x + dx;
+        piece.dy = oy * cos - ox * sin + origin.y + dy;
+        const float c = piece.cos * cos - piece.sin * sin;
+        piece.sin = piece.sin * cos + piece.cos * sin;
+        piece.cos = c;
+        piece.degrees += degrees;
+        piece.moved = true;
+    }
+    return view;
+}
+
+size_t decodedSize(const asset& path) {
+    if (!isBinary(path)) return 0;
+    Header header;
+    std::memcpy(&header, path.buf, sizeof(Header));
+    return size_t(header.count) * pointSize(header.flags);
+}
+
+static bool readVarint(const uint8_t*& cursor, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && cursor < end; shift += 7) {
+        const uint8_t byte = *cursor++;
+        value |= uint32_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+static int32_t unzigzag(uint32_t value) { return int32_t(value >> 1) ^ -int32_t(value & 1); }
+
+PathView decode(const asset& path, uint8_t* out, size_t capacity, LoadResult* result) {
+    Header header;
+    LoadResult status = validate(path, &header);
+    const size_t stride = pointSize(header.flags);
+    if (status == LoadResult::OK && capacity < size_t(header.count) * stride) status = LoadResult::BUFFER_TOO_SMALL;
+
+    if (status == LoadResult::OK && !(header.flags & FLAG_COMPRESSED)) {
+        std::memcpy(out, path.buf + sizeof(Header), size_t(header.count) * stride);
+    } else if (status == LoadResult::OK) {
+        const uint8_t* cursor = path.buf + sizeof(Header);
+        const uint8_t* end = path.buf + path.size;
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t speed = 0;
+        for (size_t i = 0; i < header.count; i++) {
+            uint32_t dx, dy, dspeed;
+            if (!readVarint(cursor, end, dx) || !readVarint(cursor, end, dy) || !readVarint(cursor, end, dspeed)) {
+                status = LoadResult::TRUNCATED;
+                break;
+            }
+            x += unzigzag(dx);
+            y += unzigzag(dy);
+            speed += unzigzag(dspeed);
+            const Point point = {x / QUANTUM, y / QUANTUM, speed / QUANTUM};
+            std::memcpy(out + i * stride, &point, sizeof(Point));
+
+            if (header.flags & FLAG_HEADING) {
+                uint32_t heading;
+                if (!readVarint(cursor, end, heading)) {
+                    status = LoadResult::TRUNCATED;
+                    break;
+                }
+                const float theta = heading == 0 ? NAN : unzigzag(heading - 1) / QUANTUM;
+                std::memcpy(out + i * stride + sizeof(Point), &theta, sizeof(float));
+            }
+        }
+    }
+
+    if (result != nullptr) *result = status;
+    if (status != LoadResult::OK) return PathView();
+    return PathView(out, header.count, stride);
+}
+} // namespace pathing
@@ -0,0 +1,76 @@
+// assetlink - links compiled path assets into the program, storing identical assets once
+//
+// Writes an assembler file that includes every unique asset with .incbin and defines the same
+// _binary_<dir>_<name>_<ext>_start/_end/_size symbols objcopy would, so PATH_ASSET and TRAJECTORY_ASSET work unchanged.
+// Assets with the same contents share one copy, their symbols are aliases. Run by firmware/path-asset.mk:
+//
+//   assetlink bin/paths/assets.s bin/paths/*.path bin/paths/*.traj
+//
+// Every asset is in its own section, so ones that are never referenced are still dropped by --gc-sections.
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "host.hpp"
+
+// the symbol objcopy would derive from the file name relative to the build directory, paths/X.path -> paths_X_path
+static std::string symbolName(const std::string& file) {
+    size_t start = file.find_last_of('/');
+    if (start != std::string::npos && start > 0) start = file.find_last_of('/', start - 1);
+    std::string name = start == std::string::npos ? file : file.substr(start + 1);
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+    }
+    return "_binary_" + name;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: assetlink <output.s> <asset>...\n");
+        return 2;
+    }
+
+    std::ofstream out(argv[1]);
+    std::map<std::vector<uint8_t>, std::string> unique;
+    size_t total = 0;
+    size_t linked = 0;
+    for (int i = 2; i < argc; i++) {
+        std::vector<uint8_t> data;
+        if (!host::readFile(argv[i], data)) {
+            std::fprintf(stderr, "assetlink: cannot read %s\n", argv[i]);
+            return 1;
+        }
+        const std::string symbol = symbolName(argv[i]);
+        total += data.size();
+        out << "    .global " << symbol << "_start\n"
+            << "    .global " << symbol << "_end\n"
+            << "    .global " << symbol << "_size\n";
+
+        const auto existing = unique.find(data);
+        if (existing != unique.end()) {
+            std::printf("assetlink: %s is identical to %s, storing it once\n", argv[i], existing->second.c_str());
+            const std::string& first = existing->second;
+            out << "    .set " << symbol << "_start, " << first << "_start\n"
+                << "    .set " << symbol << "_end, " << first << "_end\n"
+                << "    .set " << symbol << "_size, " << first << "_size\n\n";
+            continue;
+        }
+        unique.emplace(data, symbol);
+        linked += data.size();
+        out << "    .section .rodata." << symbol << ",\"a\",%progbits\n"
+            << "    .balign 4\n"
+            << symbol << "_start:\n"
+            << "    .incbin \"" << argv[i] << "\"\n"
+            << symbol << "_end:\n"
+            << "    .set " << symbol << "_size, " << symbol << "_end - " << symbol << "_start\n\n";
+    }
+    if (!out) {
+        std::fprintf(stderr, "assetlink: cannot write %s\n", argv[1]);
+        return 1;
+    }
+    std::printf("assetlink: %d assets, %zu bytes, %zu after removing duplicates\n", argc - 2, total, linked);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+// Simulated robot positions and drivetrain shared by the path benches
+
+#include <cmath>
+#include <vector>
+#include "path/pursuit.hpp"
+#include "path/view.hpp"
+
+struct Position {
+        float x;
+        float y;
+};
+
+// robot positions along the path at 60 in/s sampled every 10 ms, weaving 1.5" either side of it
+inline std::vector<Position> drive(const pathing::PathView& path, bool relocalize) {
+    std::vector<Position> positions;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        const pathing::Point a = path[i];
+        const pathing::Point b = path[i + 1];
+        const float length = std::hypot(b.x - a.x, b.y - a.y);
+        if (length == 0) continue;
+        for (float s = 0; s < length; s += 0.6f) {
+            const float t = s / length;
+            const float offset = 1.5f * std::sin(positions.size() * 0.05f);
+            positions.push_back({a.x + (b.x - a.x) * t - (b.y - a.y) / length * offset,
+                                 a.y + (b.y - a.y) * t + (b.x - a.x) / length * offset});
+        }
+    }
+    // a large odometry correction half way through
+    if (relocalize) {
+        for (size_t i = positions.size() / 2; i < positions.size() / 2 + 5 && i < positions.size(); i++) {
+            positions[i].x += 24;
+        }
+    }
+    return positions;
+}
+
+// a drivetrain like the one in src/config.cpp: 3.25" wheels at 450 rpm and an 11.4" track. Wheel speed follows motor
+// power with a 100 ms lag and the right side only makes 95% of the left's speed, which is what makes a robot drift
+struct SimRobot {
+        static constexpr float WHEEL_SPEED = 450.0f / 60 * M_PI * 3.25f; // inches per second at full power
+        static constexpr float TRACK = 11.4;
+        static constexpr float LAG = 0.1;
+        static constexpr float RIGHT_WEAKNESS = 0.95;
+
+        float x;
+        float y;
+        float heading; // radians, clockwise from +y
+        float left = 0; // wheel speeds, inches per second
+        float right = 0;
+
+        void step(float leftPower, float rightPower, float dt) {
+            left += (leftPower / 127 * WHEEL_SPEED - left) * dt / LAG;
+            right += (rightPower / 127 * WHEEL_SPEED * RIGHT_WEAKNESS - right) * dt / LAG;
+            const float velocity = (left + right) / 2;
+            heading += (left - right) / TRACK * dt;
+            x += velocity * std::sin(heading) * dt;
+            y += velocity * std::cos(heading) * dt;
+        }
+};
+
+// the curvature of the arc from the robot through a point, the same as the followers in src/motion/follow.cpp
+inline float arcCurvature(const SimRobot& robot, float x, float y) {
+    const float heading = M_PI / 2 - robot.heading;
+    const float side = (std::sin(heading) * (x - robot.x) - std::cos(heading) * (y - robot.y)) > 0 ? 1 : -1;
+    const float a = -std::tan(heading);
+    const float c = std::tan(heading) * robot.x - robot.y;
+    const float offset = std::fabs(a * x + y + c) / std::sqrt(a * a + 1);
+    const float d = std::hypot(x - robot.x, y - robot.y);
+    return side * 2 * offset / (d * d);
+}
+
+// distance from a position to the closest segment of a path
+inline float crossTrack(const pathing::PathView& path, float x, float y) {
+    float best = INFINITY;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        const pathing::Point a = path[i];
+        const pathing::Point b = path[i + 1];
+        const float dx = b.x - a.x;
+        const float dy = b.y - a.y;
+        const float length = dx * dx + dy * dy;
+        const float t = length > 0 ? std::fmin(std::fmax(((x - a.x) * dx + (y - a.y) * dy) / length, 0), 1) : 0;
+        best = std::fmin(best, std::hypot(a.x + dx * t - x, a.y + dy * t - y));
+    }
+    return best;
+}
+
+// how well pure pursuit followed a path
+struct FollowResult {
+        float maxError; // furthest from the reference path, inches
+        float rmsError;
+        float time; // seconds until the path ended, NAN if it didn't in 30 s
+};
+
+// runs the loop in Chassis::pursue() on SimRobot every 10 ms, starting on the path, until the closest point has speed
+// 0. Cross track error is measured against reference, so a resampled path can be scored against the original
+inline FollowResult followPath(const pathing::PathView& path, const pathing::LookaheadPolicy& policy,
+                               const pathing::PathView& reference) {
+    constexpr float DT = 0.01;
+    const pathing::Point first = path[0];
+    const pathing::Point second = path[1];
+    SimRobot robot {first.x, first.y, std::atan2(second.x - first.x, second.y - first.y)};
+    pathing::PathCursor cursor(path);
+    FollowResult result {0, 0, NAN};
+    size_t ticks = 0;
+    for (float t = 0; t < 30; t += DT) {
+        const size_t closest = cursor.update(robot.x, robot.y);
+        const float speed = path[closest].speed;
+        if (speed == 0) {
+            result.time = t;
+            break;
+        }
+        const float lookahead =
+            policy.lookahead(speed, policy.adaptive() ? cursor.curvatureAhead(policy.speedLookahead(speed)) : 0);
+        const pathing::Point target = cursor.lookahead(robot.x, robot.y, lookahead);
+        const float curvature =
+            std::hypot(target.x - robot.x, target.y - robot.y) < 0.01 ? 0 : arcCurvature(robot, target.x, target.y);
+        float left = speed * (2 + curvature * SimRobot::TRACK) / 2;
+        float right = speed * (2 - curvature * SimRobot::TRACK) / 2;
+        const float ratio = std::fmax(std::fabs(left), std::fabs(right)) / 127;
+        if (ratio > 1) {
+            left /= ratio;
+            right /= ratio;
+        }
+        robot.step(left, right, DT);
+
+        const float error = crossTrack(reference, robot.x, robot.y);
+        result.maxError = std::fmax(result.maxError, error);
+        result.rmsError += error * error;
+        ticks++;
+    }
+    result.rmsError = std::sqrt(result.rmsError / (ticks > 0 ? ticks : 1));
+    return result;
+}
@@ -0,0 +1,87 @@
+// Size of the compressed path encoding against raw floats and the original text, and what decoding costs
+//
+//   make bench
+//   bin/tools/bench_encode static/*.txt PlanRoutes/*.txt
+//
+// Paths are resampled with the default ResampleSettings first, the same as a path that opts in with
+// PATH_TOLERANCE_<name> in the asset build.
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "path/parser.hpp"
+#include "path/resample.hpp"
+#include "path/view.hpp"
+#include "../host.hpp"
+
+int main(int argc, char** argv) {
+    std::printf("%-24s %7s %8s %8s %8s %7s %10s %10s\n", "path", "points", "text", "raw", "packed", "ratio",
+                "decode ns", "max error");
+
+    size_t textTotal = 0;
+    size_t rawTotal = 0;
+    size_t packedTotal = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".txt") != 0) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+
+        const char* begin = reinterpret_cast<const char*>(file.data());
+        pathing::TextParser parser(begin, begin + file.size());
+        pathing::TextPoint point;
+        pathing::TextParser::Status status;
+        std::vector<pathing::Point> points;
+        std::vector<float> headings;
+        while ((status = parser.next(point)) != pathing::TextParser::Status::END) {
+            if (status != pathing::TextParser::Status::POINT) continue;
+            points.push_back({point.x, point.y, point.speed});
+            headings.push_back(point.heading);
+        }
+
+        std::vector<pathing::Point> resampled;
+        std::vector<float> resampledHeadings;
+        pathing::resample(points, headings, {}, resampled, resampledHeadings);
+
+        std::vector<uint8_t> raw = pathing::encode(resampled);
+        std::vector<uint8_t> packed = pathing::encode(resampled, {}, true);
+        const asset packedAsset = {packed.data(), packed.size()};
+        std::vector<uint8_t> buffer(pathing::decodedSize(packedAsset));
+
+        pathing::LoadResult result;
+        const pathing::PathView view = pathing::decode(packedAsset, buffer.data(), buffer.size(), &result);
+        if (result != pathing::LoadResult::OK) {
+            std::fprintf(stderr, "%s: %s\n", argv[i], pathing::toString(result));
+            return 1;
+        }
+        float error = 0;
+        for (size_t k = 0; k < resampled.size(); k++) {
+            error = std::fmax(error, std::fabs(view[k].x - resampled[k].x));
+            error = std::fmax(error, std::fabs(view[k].y - resampled[k].y));
+            error = std::fmax(error, std::fabs(view[k].speed - resampled[k].speed));
+        }
+
+        size_t sink = 0;
+        const double decodeNs = host::timeNs([&]() {
+            sink += pathing::decode(packedAsset, buffer.data(), buffer.size()).size();
+        });
+        host::keep(sink);
+
+        textTotal += file.size();
+        rawTotal += raw.size();
+        packedTotal += packed.size();
+        std::printf("%-24s %7zu %8zu %8zu %8zu %6.1fx %10.0f %10.4f\n", host::baseName(name).c_str(),
+                    resampled.size(), file.size(), raw.size(), packed.size(), double(raw.size()) / packed.size(),
+                    decodeNs, error);
+    }
+
+    if (packedTotal > 0) {
+        std::printf("\ntext %zu bytes, raw %zu, packed %zu (%.1fx smaller than raw)\n", textTotal, rawTotal,
+                    packedTotal, double(rawTotal) / packedTotal);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+// LemLib's moveToPoint, turnToHeading and swingToHeading loops with the controller settings in src/config.cpp, run on
+// SimRobot every 10 ms until a settle condition is met, shared by the motion benches
+
+#include <cmath>
+#include "motion/settle.hpp"
+#include "drive.hpp"
+
+struct SimResult {
+        uint32_t time; // milliseconds until the motion ended
+        float error; // error once the robot has coasted to a stop, inches or degrees
+};
+
+// lemlib::PID, the derivative is per tick
+struct SimPid {
+        float kP;
+        float kD;
+        float last = NAN;
+
+        float update(float error) {
+            const float derivative = std::isnan(last) ? 0 : error - last;
+            last = error;
+            return kP * error + kD * derivative;
+        }
+};
+
+static constexpr float SIM_DT = 0.01;
+static constexpr uint32_t SIM_TIMEOUT = 3000;
+
+// power left once ks of it is lost to static friction, so the robot can stall short of the target the way a real one
+// does
+inline float simFriction(float power, float ks) {
+    return std::copysign(std::fmax(std::fabs(power) - ks, 0.0f), power);
+}
+
+// a side held by its motors doesn't move
+inline void simHold(SimRobot& robot, bool right) {
+    if (right) {
+        robot.right = 0;
+    } else {
+        robot.left = 0;
+    }
+}
+
+inline void simCoast(SimRobot& robot) {
+    for (int i = 0; i < 100; i++) robot.step(0, 0, SIM_DT);
+}
+
+inline SimResult simMove(float distance, motion::SettleCondition settle, float ks, float maxSpeed = 127) {
+    SimRobot robot {0, 0, 0};
+    SimPid lateralPid {10, 7};
+    SimPid angularPid {2, 10};
+    float lateralOut = 0;
+    uint32_t time = 0;
+    for (; time < SIM_TIMEOUT; time += 10) {
+        const float dx = -robot.x;
+        const float dy = distance - robot.y;
+        const float error = std::hypot(dx, dy);
+        const float speed = (robot.left + robot.right) / 2;
+        if (settle.update(error, speed, time)) break;
+
+        const float headingError = std::remainder(std::atan2(dx, dy) - robot.heading, 2 * M_PI);
+        float lateral = lateralPid.update(error * std::cos(headingError));
+        lateral = std::fmax(std::fmin(lateral, maxSpeed), -maxSpeed);
+        // LemLib's slew limits acceleration only
+        if (std::fabs(lateral) > std::fabs(lateralOut)) {
+            lateralOut += std::fmax(std::fmin(lateral - lateralOut, 20.0f), -20.0f);
+        } else {
+            lateralOut = lateral;
+        }
+        const float angular = error < 7.5 ? 0 : angularPid.update(headingError * 180 / M_PI);
+        float left = lateralOut + angular;
+        float right = lateralOut - angular;
+        const float ratio = std::fmax(std::fabs(left), std::fabs(right)) / maxSpeed;
+        if (ratio > 1) {
+            left /= ratio;
+            right /= ratio;
+        }
+        robot.step(simFriction(left, ks), simFriction(right, ks), SIM_DT);
+    }
+    simCoast(robot);
+    return {time, std::hypot(robot.x, distance - robot.y)};
+}
+
+inline SimResult simTurn(float degrees, motion::SettleCondition settle, float ks, float maxSpeed = 127) {
+    SimRobot robot {0, 0, 0};
+    SimPid angularPid {2, 10};
+    const float target = degrees * M_PI / 180;
+    uint32_t time = 0;
+    for (; time < SIM_TIMEOUT; time += 10) {
+        const float error = std::remainder(target - robot.heading, 2 * M_PI) * 180 / M_PI;
+        const float rate = (robot.left - robot.right) / SimRobot::TRACK * 180 / M_PI;
+        if (settle.update(error, rate, time)) break;
+        const float angular = std::fmax(std::fmin(angularPid.update(error), maxSpeed), -maxSpeed);
+        robot.step(simFriction(angular, ks), simFriction(-angular, ks), SIM_DT);
+    }
+    simCoast(robot);
+    return {time, float(std::fabs(std::remainder(target - robot.heading, 2 * M_PI)) * 180 / M_PI)};
+}
+
+// the locked side holds its position, a degrees is positive clockwise
+inline SimResult simSwing(float degrees, bool lockRight, motion::SettleCondition settle, float ks,
+                          float maxSpeed = 127) {
+    SimRobot robot {0, 0, 0};
+    SimPid angularPid {2, 10};
+    const float target = degrees * M_PI / 180;
+    uint32_t time = 0;
+    for (; time < SIM_TIMEOUT; time += 10) {
+        const float error = std::remainder(target - robot.heading, 2 * M_PI) * 180 / M_PI;
+        const float rate = (robot.left - robot.right) / SimRobot::TRACK * 180 / M_PI;
+        if (settle.update(error, rate, time)) break;
+        const float angular = std::fmax(std::fmin(angularPid.update(error), maxSpeed), -maxSpeed);
+        robot.step(lockRight ? simFriction(angular, ks) : 0, lockRight ? 0 : simFriction(-angular, ks), SIM_DT);
+        simHold(robot, lockRight);
+    }
+    simCoast(robot);
+    return {time, float(std::fabs(std::remainder(target - robot.heading, 2 * M_PI)) * 180 / M_PI)};
+}
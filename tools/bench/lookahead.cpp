@@ -0,0 +1,50 @@
+// Cross track error and completion time of pure pursuit with fixed lookaheads against LookaheadPolicy
+//
+//   make bench
+//   bin/tools/bench_lookahead bin/paths/*.path
+//
+// Runs the loop in Chassis::pursue() on SimRobot, see followPath() in drive.hpp. The time is until the closest point
+// is the last one, "-" if the robot never got there in 30 s. Arguments that aren't .path files are ignored.
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "path/pursuit.hpp"
+#include "../host.hpp"
+#include "drive.hpp"
+
+int main(int argc, char** argv) {
+    const pathing::LookaheadPolicy policies[] = {pathing::LookaheadPolicy::fixed(8),
+                                                 pathing::LookaheadPolicy::fixed(10), pathing::LookaheadPolicy()};
+    std::printf("%-24s %24s %24s %24s\n", "path", "fixed 8 max / rms / s", "fixed 10 max / rms / s",
+                "adaptive max / rms / s");
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 5 || name.compare(name.size() - 5, 5, ".path") != 0) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        const asset data = {file.data(), file.size()};
+        std::vector<uint8_t> decoded(pathing::decodedSize(data));
+        pathing::LoadResult loaded;
+        const pathing::PathView path = pathing::decode(data, decoded.data(), decoded.size(), &loaded);
+        if (loaded != pathing::LoadResult::OK) {
+            std::fprintf(stderr, "%s: %s\n", argv[i], pathing::toString(loaded));
+            return 1;
+        }
+        if (path.size() < 2) continue;
+
+        std::printf("%-24s", host::baseName(name).c_str());
+        for (const pathing::LookaheadPolicy& policy : policies) {
+            const FollowResult result = followPath(path, policy, path);
+            char time[16] = "-";
+            if (!std::isnan(result.time)) std::snprintf(time, sizeof(time), "%.2f", result.time);
+            std::printf(" %6.2f\" %6.2f\" %7s", result.maxError, result.rmsError, time);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
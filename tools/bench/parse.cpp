@@ -0,0 +1,131 @@
+// Text path parse throughput, LemLib's getData vs TextParser
+//
+//   make bench
+//   bin/tools/bench_parse static/*.txt PlanRoutes/*.txt
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "path/parser.hpp"
+#include "../host.hpp"
+
+// every heap allocation made by the process, to show what each parser allocates
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Pose {
+        float x;
+        float y;
+        float theta;
+};
+
+// LemLib 0.5's readElement, split a string on a delimiter
+static std::vector<std::string> readElement(const std::string& input, const std::string& delimiter) {
+    std::string token;
+    std::string s = input;
+    std::vector<std::string> output;
+    size_t pos = 0;
+    while ((pos = s.find(delimiter)) != std::string::npos) {
+        token = s.substr(0, pos);
+        output.push_back(token);
+        s.erase(0, pos + delimiter.length());
+    }
+    output.push_back(s);
+    return output;
+}
+
+// LemLib 0.5's getData, what chassis.follow does with a text asset every time it is called
+static std::vector<Pose> getData(const std::vector<uint8_t>& file) {
+    std::vector<Pose> robotPath;
+    const std::string text(file.begin(), file.end());
+    for (const std::string& line : readElement(text, "\n")) {
+        if (line == "endData" || line == "endData\r") break;
+        const std::vector<std::string> pointInput = readElement(line, ", ");
+        robotPath.push_back({std::stof(pointInput.at(0)), std::stof(pointInput.at(1)), std::stof(pointInput.at(2))});
+    }
+    return robotPath;
+}
+
+static size_t parse(const std::vector<uint8_t>& file) {
+    const char* begin = reinterpret_cast<const char*>(file.data());
+    pathing::TextParser parser(begin, begin + file.size());
+    pathing::TextPoint point;
+    pathing::TextParser::Status status;
+    size_t points = 0;
+    while ((status = parser.next(point)) != pathing::TextParser::Status::END) {
+        if (status == pathing::TextParser::Status::POINT) points++;
+    }
+    return points;
+}
+
+int main(int argc, char** argv) {
+    std::printf("%-24s %-8s %7s %6s %10s %10s %9s %8s %8s\n", "path", "format", "bytes", "points", "lemlib MB/s",
+                "parser MB/s", "speedup", "lemlib", "parser");
+    std::printf("%-24s %-8s %7s %6s %10s %10s %9s %8s %8s\n", "", "", "", "", "", "", "", "allocs", "allocs");
+
+    double lemlibTotal = 0;
+    double parserTotal = 0;
+    size_t bytesTotal = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".txt") != 0) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+
+        const char* begin = reinterpret_cast<const char*>(file.data());
+        pathing::TextParser probe(begin, begin + file.size());
+        pathing::TextPoint point;
+        probe.next(point);
+        const char* format = probe.format() == pathing::TextFormat::JERRYIO_V01 ? "jerryio" : "lemlib";
+
+        size_t before = allocations;
+        const size_t points = parse(file);
+        const size_t parserAllocs = allocations - before;
+        const double parserNs = host::timeNs([&]() { host::keep(parse(file)); });
+
+        // getData throws on anything it doesn't expect, which on the brain takes down the program
+        bool lemlibOk = true;
+        before = allocations;
+        try {
+            getData(file);
+        } catch (const std::exception&) {
+            lemlibOk = false;
+        }
+        const size_t lemlibAllocs = allocations - before;
+
+        const double mb = file.size() / 1e6;
+        if (lemlibOk) {
+            const double lemlibNs = host::timeNs([&]() { host::keep(getData(file).size()); });
+            lemlibTotal += lemlibNs;
+            parserTotal += parserNs;
+            bytesTotal += file.size();
+            std::printf("%-24s %-8s %7zu %6zu %10.1f %10.1f %8.1fx %8zu %8zu\n", host::baseName(name).c_str(), format,
+                        file.size(), points, mb / (lemlibNs * 1e-9), mb / (parserNs * 1e-9), lemlibNs / parserNs,
+                        lemlibAllocs, parserAllocs);
+        } else {
+            std::printf("%-24s %-8s %7zu %6zu %10s %10.1f %9s %8s %8zu\n", host::baseName(name).c_str(), format,
+                        file.size(), points, "throws", mb / (parserNs * 1e-9), "-", "-", parserAllocs);
+        }
+    }
+
+    if (bytesTotal > 0) {
+        std::printf("\nfiles both parse: %.1f MB/s vs %.1f MB/s, %.1fx\n", bytesTotal / 1e6 / (lemlibTotal * 1e-9),
+                    bytesTotal / 1e6 / (parserTotal * 1e-9), lemlibTotal / parserTotal);
+    }
+    return 0;
+}
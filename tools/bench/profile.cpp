@@ -0,0 +1,132 @@
+// Straight moves with the lateral PID alone against profiled moves and their feedforward, on a simulated drivetrain
+//
+//   make bench
+//   bin/tools/bench_profile
+//
+// The drivetrain is the one in src/config.cpp: 3.25" wheels at 450 rpm, lateral PID kP 10 kD 7 with a slew of 20,
+// exiting after 100 ms within 1" or 500 ms within 3". Wheel speed follows motor power with a 100 ms lag, the first
+// 8 power only overcomes friction, and the wheels slip past 250 in/s^2. Every controller runs every 10 ms and the
+// move ends when the exit conditions do, which can be while the robot is still moving. Arguments are ignored.
+
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include "motion/feedforward.hpp"
+#include "path/profile.hpp"
+
+static constexpr float DT = 0.01;
+static constexpr float WHEEL_SPEED = 450.0f / 60 * M_PI * 3.25f; // inches per second at full power
+static constexpr float LAG = 0.1;
+static constexpr float FRICTION = 8;
+static constexpr float TRACTION = 250; // most the wheels can accelerate or brake before slipping, in/s^2
+static constexpr float KP = 10;
+static constexpr float KD = 7;
+static constexpr float SLEW = 20;
+
+namespace {
+// LemLib's PID and exit conditions
+struct Pid {
+        float kP = KP;
+        float previous = 0;
+
+        float update(float error) {
+            const float derivative = error - previous;
+            previous = error;
+            return kP * error + KD * derivative;
+        }
+};
+
+struct Exit {
+        float range;
+        float time;
+        float inside = 0;
+
+        bool update(float error) {
+            inside = std::fabs(error) < range ? inside + DT : 0;
+            return inside >= time;
+        }
+};
+
+struct Result {
+        float time; /** seconds until the exit conditions ended the move */
+        float error; /** distance from the target when the move ended, inches */
+        float tracking; /** furthest the robot fell behind or ran ahead of the profile, inches */
+};
+} // namespace
+
+// the drivetrain's response to a power
+static float accelerate(float power, float velocity) {
+    const float push = std::fmax(std::fabs(power) - FRICTION, 0.0f) * (power < 0 ? -1 : 1);
+    const float acceleration = (push / 127 * WHEEL_SPEED - velocity) / LAG;
+    return std::fmax(std::fmin(acceleration, TRACTION), -TRACTION);
+}
+
+template <typename Controller> static Result simulate(float distance, Controller controller) {
+    float position = 0;
+    float velocity = 0;
+    Exit small {1, 0.1};
+    Exit large {3, 0.5};
+    for (float t = 0; t < 5; t += DT) {
+        const float error = distance - position;
+        if (small.update(error) || large.update(error)) return {t, std::fabs(error), 0};
+        const float power = std::fmax(std::fmin(controller(t, position, error), 127.0f), -127.0f);
+        velocity += accelerate(power, velocity) * DT;
+        position += velocity * DT;
+    }
+    return {5, std::fabs(distance - position), 0};
+}
+
+static Result pidOnly(float distance) {
+    Pid pid;
+    float last = 0;
+    return simulate(distance, [&](float, float, float error) {
+        float out = std::fmax(std::fmin(pid.update(error), 127.0f), -127.0f);
+        // LemLib slews until the robot is close to the target
+        if (error > 7.5f) out = std::fmax(std::fmin(out, last + SLEW), last - SLEW);
+        last = out;
+        return out;
+    });
+}
+
+static Result profiled(float distance, const pathing::ProfileLimits& limits, const motion::Feedforward& feedforward,
+                       float kP) {
+    const pathing::MotionProfile profile(distance, limits);
+    Pid pid {kP};
+    float tracking = 0;
+    Result result = simulate(distance, [&](float t, float position, float error) {
+        if (t >= profile.duration()) return pid.update(error);
+        const pathing::ProfileState target = profile.sample(t);
+        tracking = std::fmax(tracking, std::fabs(target.position - position));
+        return feedforward.power(target.velocity, target.acceleration) + pid.update(target.position - position);
+    });
+    result.tracking = tracking;
+    return result;
+}
+
+int main() {
+    // the limits suggested in src/config.cpp. With a 2000 in/s^3 jerk limit every profiled column is slower still
+    const pathing::ProfileLimits limits {70, 200, 0};
+    // the chassis' free speed model, and gains that match the simulated drivetrain
+    const float kV = 127 / WHEEL_SPEED;
+    const motion::Feedforward freeSpeed {0, kV, kV * LAG};
+    const motion::Feedforward matched {FRICTION, kV, kV * LAG};
+
+    std::printf("%8s %16s %26s %26s %26s\n", "", "pid kP 10", "free speed ff, kP 10", "matched ff, kP 10",
+                "matched ff, kP 4");
+    std::printf("%8s %16s %26s %26s %26s\n", "inches", "s / error", "s / error / tracking", "", "");
+    float totals[4] = {0, 0, 0, 0};
+    for (float distance : {6.0f, 12.0f, 24.0f, 36.0f, 48.0f, 72.0f}) {
+        const Result results[4] = {pidOnly(distance), profiled(distance, limits, freeSpeed, KP),
+                                   profiled(distance, limits, matched, KP), profiled(distance, limits, matched, 4)};
+        std::printf("%8.0f %7.2f %7.2f\"", distance, results[0].time, results[0].error);
+        for (int i = 1; i < 4; i++) {
+            std::printf(" %7.2f %7.2f\" %7.2f\"", results[i].time, results[i].error, results[i].tracking);
+        }
+        for (int i = 0; i < 4; i++) totals[i] += results[i].time;
+        std::printf("\n");
+    }
+    std::printf("\ntotal %.2f s with the PID alone, %.2f s free speed feedforward, %.2f s matched, %.2f s matched with "
+                "kP 4\n",
+                totals[0], totals[1], totals[2], totals[3]);
+    return 0;
+}
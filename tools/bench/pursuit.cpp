@@ -0,0 +1,119 @@
+// Per tick cost of the pure pursuit point search, full rescan vs PathCursor
+//
+//   make bench
+//   bin/tools/bench_pursuit bin/paths/*.path
+//
+// Arguments that aren't .path files are ignored.
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include "path/pursuit.hpp"
+#include "../host.hpp"
+#include "drive.hpp"
+
+// the search LemLib does: scan every point for the closest, then walk forward until the lookahead circle is hit
+struct FullScan {
+        pathing::PathView path;
+        size_t lookaheadIndex = 0;
+
+        size_t update(float x, float y, float lookaheadDist) {
+            size_t closest = 0;
+            float closestDist = std::numeric_limits<float>::infinity();
+            for (size_t i = 0; i < path.size(); i++) {
+                const float dist = std::hypot(path[i].x - x, path[i].y - y);
+                if (dist < closestDist) {
+                    closestDist = dist;
+                    closest = i;
+                }
+            }
+            for (size_t i = std::max(closest, lookaheadIndex); i + 1 < path.size(); i++) {
+                if (pathing::circleIntersect(path[i], path[i + 1], x, y, lookaheadDist) != -1) {
+                    lookaheadIndex = i;
+                    break;
+                }
+            }
+            return closest;
+        }
+};
+
+static void run(const char* name, const pathing::PathView& path, bool relocalize) {
+    const std::vector<Position> positions = drive(path, relocalize);
+    if (positions.empty()) return;
+    const float lookahead = 8;
+
+    size_t sink = 0;
+    const double fullNs = host::timeNs([&]() {
+        FullScan search {path};
+        for (const Position& p : positions) sink += search.update(p.x, p.y, lookahead);
+    });
+    const double cursorNs = host::timeNs([&]() {
+        pathing::PathCursor cursor(path);
+        for (const Position& p : positions) {
+            sink += cursor.update(p.x, p.y);
+            cursor.lookahead(p.x, p.y, lookahead);
+        }
+    });
+    // construction cost of the cursor (segment grid build), paid once per follow
+    const double setupNs = host::timeNs([&]() {
+        pathing::PathCursor cursor(path);
+        sink += cursor.closest();
+    });
+
+    // how often the cursor disagrees with the full rescan about the closest point
+    FullScan search {path};
+    pathing::PathCursor cursor(path);
+    size_t mismatches = 0;
+    for (const Position& p : positions) {
+        if (search.update(p.x, p.y, lookahead) != cursor.update(p.x, p.y)) mismatches++;
+        cursor.lookahead(p.x, p.y, lookahead);
+    }
+
+    host::keep(sink);
+
+    std::printf("%-24s %6zu %6zu %12.0f %12.0f %8.1fx %10.0f %8zu\n", name, path.size(), positions.size(),
+                fullNs / positions.size(), cursorNs / positions.size(), fullNs / cursorNs, setupNs, mismatches);
+}
+
+int main(int argc, char** argv) {
+    std::printf("%-24s %6s %6s %12s %12s %9s %10s %8s\n", "path", "points", "ticks", "full ns/tick",
+                "cursor ns/tick", "speedup", "setup ns", "differ");
+
+    std::vector<std::vector<uint8_t>> files(argc);
+    std::vector<std::vector<uint8_t>> decoded(argc);
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 5 || name.compare(name.size() - 5, 5, ".path") != 0) continue;
+        if (!host::readFile(argv[i], files[i])) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        const asset file = {files[i].data(), files[i].size()};
+        pathing::LoadResult result;
+        decoded[i].resize(pathing::decodedSize(file));
+        const pathing::PathView path = pathing::decode(file, decoded[i].data(), decoded[i].size(), &result);
+        if (result != pathing::LoadResult::OK) {
+            std::fprintf(stderr, "%s: %s\n", argv[i], pathing::toString(result));
+            return 1;
+        }
+        run(host::baseName(argv[i]).c_str(), path, false);
+    }
+
+    // synthetic serpentine paths to show how the cost scales with length
+    std::printf("\nsynthetic paths, with a 24\" relocalization half way\n");
+    for (size_t count = 64; count <= 4096; count *= 4) {
+        std::vector<pathing::Point> points;
+        for (size_t i = 0; i < count; i++) {
+            // 144" rows 12" apart, alternating direction
+            const float s = i * 2.0f;
+            const int row = int(s / 144);
+            const float along = std::fmod(s, 144.0f);
+            points.push_back({row % 2 == 0 ? along - 72 : 72 - along, row * 12 + 3 * std::sin(s / 10), 100});
+        }
+        const std::vector<uint8_t> data = pathing::encode(points);
+        const asset file = {const_cast<uint8_t*>(data.data()), data.size()};
+        const std::string name = "serpentine-" + std::to_string(count);
+        run(name.c_str(), pathing::PathView::fromAsset(file), true);
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Cross track error of time indexed pure pursuit against RAMSETE, tracking trajectories on a simulated drivetrain
+//
+//   make bench
+//   bin/tools/bench_ramsete bin/paths/*.traj
+//
+// The drivetrain is SimRobot in drive.hpp. The robot starts 1.5" left of the trajectory and 4 degrees off. Both
+// controllers use the free speed feedforward and run every 10 ms. Arguments that aren't .traj files are ignored.
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "motion/feedforward.hpp"
+#include "path/ramsete.hpp"
+#include "path/trajectory.hpp"
+#include "../host.hpp"
+#include "drive.hpp"
+
+static constexpr float DT = 0.01;
+static constexpr float TRACK = SimRobot::TRACK;
+static constexpr float LOOKAHEAD = 8;
+static constexpr float SETTLE_TIME = 0.5; // seconds to take out the starting error before max error counts
+
+namespace {
+struct Result {
+        float maxError; /** furthest from the trajectory after SETTLE_TIME, inches */
+        float rmsError;
+        float endError; /** distance from the end of the trajectory when it ends, inches */
+};
+} // namespace
+
+static const motion::Feedforward FEEDFORWARD {0, 127 / SimRobot::WHEEL_SPEED,
+                                              127 / SimRobot::WHEEL_SPEED * SimRobot::LAG};
+
+// distance from a position to the closest sample of the trajectory
+static float crossTrack(const pathing::TrajectoryView& trajectory, float x, float y) {
+    float best = INFINITY;
+    for (size_t i = 0; i < trajectory.size(); i++) {
+        best = std::fmin(best, std::hypot(trajectory[i].x - x, trajectory[i].y - y));
+    }
+    return best;
+}
+
+template <typename Controller>
+static Result simulate(const pathing::TrajectoryView& trajectory, Controller controller) {
+    const pathing::TrajectorySample first = trajectory.front();
+    const float heading = first.heading * M_PI / 180;
+    SimRobot robot {first.x - 1.5f * std::cos(heading), first.y + 1.5f * std::sin(heading),
+                 heading + float(4 * M_PI / 180)};
+    Result result {0, 0, 0};
+    size_t ticks = 0;
+    for (float t = 0; t <= trajectory.duration(); t += DT) {
+        const pathing::TrajectorySample target = trajectory[trajectory.indexAt(t)];
+        float left;
+        float right;
+        controller(robot, trajectory, trajectory.indexAt(t), target, left, right);
+        robot.step(left, right, DT);
+        const float error = crossTrack(trajectory, robot.x, robot.y);
+        if (t >= SETTLE_TIME) result.maxError = std::fmax(result.maxError, error);
+        result.rmsError += error * error;
+        ticks++;
+    }
+    result.rmsError = std::sqrt(result.rmsError / ticks);
+    result.endError = std::hypot(trajectory.back().x - robot.x, trajectory.back().y - robot.y);
+    return result;
+}
+
+// the trajectory follower in src/motion/follow.cpp: steer at the sample LOOKAHEAD inches past the target
+static Result pursuit(const pathing::TrajectoryView& trajectory) {
+    size_t lookaheadIndex = 0;
+    return simulate(trajectory, [&](const SimRobot& robot, const pathing::TrajectoryView& samples, size_t index,
+                                    const pathing::TrajectorySample& target, float& left, float& right) {
+        lookaheadIndex = std::max(lookaheadIndex, index);
+        while (lookaheadIndex + 1 < samples.size() &&
+               std::hypot(samples[lookaheadIndex].x - target.x, samples[lookaheadIndex].y - target.y) < LOOKAHEAD) {
+            lookaheadIndex++;
+        }
+        const pathing::TrajectorySample steer = samples[lookaheadIndex];
+        const float curvature = std::hypot(steer.x - robot.x, steer.y - robot.y) < 0.01
+                                    ? target.curvature
+                                    : arcCurvature(robot, steer.x, steer.y);
+        const float leftScale = (2 + curvature * TRACK) / 2;
+        const float rightScale = (2 - curvature * TRACK) / 2;
+        left = FEEDFORWARD.power(target.velocity * leftScale, target.acceleration * leftScale);
+        right = FEEDFORWARD.power(target.velocity * rightScale, target.acceleration * rightScale);
+    });
+}
+
+// src/motion/ramsete.cpp
+static Result ramsete(const pathing::TrajectoryView& trajectory) {
+    return simulate(trajectory, [&](const SimRobot& robot, const pathing::TrajectoryView& samples, size_t index,
+                                    const pathing::TrajectorySample& target, float& left, float& right) {
+        const pathing::ChassisSpeeds speeds = pathing::ramsete(target, robot.x, robot.y, robot.heading, {});
+        const pathing::WheelSpeeds accelerations = pathing::wheelAccelerations(samples, index, TRACK);
+        left = FEEDFORWARD.power(speeds.velocity + speeds.angular * TRACK / 2, accelerations.left);
+        right = FEEDFORWARD.power(speeds.velocity - speeds.angular * TRACK / 2, accelerations.right);
+    });
+}
+
+int main(int argc, char** argv) {
+    std::printf("%-24s %8s %26s %26s\n", "trajectory", "top in/s", "pursuit max / rms / end",
+                "ramsete max / rms / end");
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 5 || name.compare(name.size() - 5, 5, ".traj") != 0) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        pathing::LoadResult loaded;
+        const pathing::TrajectoryView trajectory =
+            pathing::TrajectoryView::fromAsset({file.data(), file.size()}, &loaded);
+        if (loaded != pathing::LoadResult::OK) {
+            std::fprintf(stderr, "%s: %s\n", argv[i], pathing::toString(loaded));
+            return 1;
+        }
+        float top = 0;
+        for (size_t k = 0; k < trajectory.size(); k++) top = std::fmax(top, trajectory[k].velocity);
+
+        const Result results[2] = {pursuit(trajectory), ramsete(trajectory)};
+        std::printf("%-24s %8.1f", host::baseName(name).c_str(), top);
+        for (const Result& result : results) {
+            std::printf(" %7.2f\" %7.2f\" %7.2f\"", result.maxError, result.rmsError, result.endError);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+// Curvature adaptive resampling: how many points it saves, how far the path moves, the per tick search cost, and
+// whether the robot still follows the path
+//
+//   make bench
+//   bin/tools/bench_resample static/*.txt PlanRoutes/*.txt bin/paths/*.path
+//
+// Uses the default ResampleSettings, the tolerances a path gets when it opts in with PATH_TOLERANCE_<name> (see
+// firmware/path-asset.mk). The follow check runs pure pursuit on SimRobot (see followPath() in drive.hpp) over the
+// original points, over them resampled, and over each compiled .path, all scored against the original points. It
+// fails if a compiled path is followed worse than its original, so a path that shouldn't be resampled fails
+// `make bench` as soon as it opts in.
+
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "path/parser.hpp"
+#include "path/pursuit.hpp"
+#include "path/resample.hpp"
+#include "../host.hpp"
+#include "drive.hpp"
+
+// distance along a path to each of its points
+static std::vector<float> arcLengths(const std::vector<pathing::Point>& points) {
+    std::vector<float> s(points.size(), 0);
+    for (size_t i = 1; i < points.size(); i++) {
+        s[i] = s[i - 1] + std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+    }
+    return s;
+}
+
+// largest distance from an original point to the resampled path, and largest speed difference. Speeds are compared
+// at the same fraction of the distance along each path, so paths that cross themselves don't get matched up wrong
+static void deviation(const std::vector<pathing::Point>& original, const std::vector<pathing::Point>& resampled,
+                      float& distance, float& speed) {
+    distance = 0;
+    for (const pathing::Point& p : original) {
+        float best = INFINITY;
+        for (size_t i = 0; i + 1 < resampled.size(); i++) {
+            const pathing::Point& a = resampled[i];
+            const pathing::Point& b = resampled[i + 1];
+            const float dx = b.x - a.x;
+            const float dy = b.y - a.y;
+            const float lengthSquared = dx * dx + dy * dy;
+            float t = lengthSquared == 0 ? 0 : ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared;
+            t = std::fmax(0, std::fmin(1, t));
+            best = std::fmin(best, std::hypot(p.x - (a.x + dx * t), p.y - (a.y + dy * t)));
+        }
+        distance = std::fmax(distance, best);
+    }
+
+    // speeds jump where one leg of a route ends and the next starts, so an original speed counts as matched if the
+    // resampled profile reaches it within an inch either way
+    speed = 0;
+    const std::vector<float> s = arcLengths(original);
+    const std::vector<float> r = arcLengths(resampled);
+    const float scale = s.back() > 0 ? r.back() / s.back() : 0;
+    auto speedAt = [&](float at) {
+        size_t k = 0;
+        while (k + 2 < resampled.size() && r[k + 1] < at) k++;
+        const float length = r[k + 1] - r[k];
+        const float t = length == 0 ? 1 : std::fmax(0, std::fmin(1, (at - r[k]) / length));
+        return resampled[k].speed + (resampled[k + 1].speed - resampled[k].speed) * t;
+    };
+    for (size_t i = 0; i < original.size(); i++) {
+        const float target = s[i] * scale;
+        float low = std::fmin(speedAt(target - 1), speedAt(target + 1));
+        float high = std::fmax(speedAt(target - 1), speedAt(target + 1));
+        for (size_t k = 0; k < resampled.size(); k++) {
+            if (std::fabs(r[k] - target) > 1) continue;
+            low = std::fmin(low, resampled[k].speed);
+            high = std::fmax(high, resampled[k].speed);
+        }
+        const float v = original[i].speed;
+        speed = std::fmax(speed, v < low ? low - v : v > high ? v - high : 0);
+    }
+}
+
+// a compiled path may be followed this much worse than its original points, max cross track in inches: the resample
+// tolerance plus 10% of the original's error
+static constexpr float FOLLOW_MARGIN = 0.25;
+static constexpr float FOLLOW_RATIO = 1.1;
+
+// per tick cost of following the path with PathCursor, with the robot driven along the original path
+static double cursorNs(const pathing::PathView& path, const std::vector<Position>& positions) {
+    size_t sink = 0;
+    const double ns = host::timeNs([&]() {
+        pathing::PathCursor cursor(path);
+        for (const Position& p : positions) {
+            sink += cursor.update(p.x, p.y);
+            cursor.lookahead(p.x, p.y, 8);
+        }
+    });
+    host::keep(sink);
+    return ns / positions.size();
+}
+
+int main(int argc, char** argv) {
+    std::printf("%-24s %7s %7s %7s %7s %9s %9s %9s %9s\n", "path", "points", "after", "bytes", "after", "max dev",
+                "speed dev", "ns/tick", "after");
+
+    // original and resampled points of each text path, by name without the extension
+    std::map<std::string, std::vector<pathing::Point>> originals;
+    std::map<std::string, std::vector<pathing::Point>> resamples;
+    size_t pointsTotal = 0;
+    size_t resampledTotal = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".txt") != 0) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+
+        const char* begin = reinterpret_cast<const char*>(file.data());
+        pathing::TextParser parser(begin, begin + file.size());
+        pathing::TextPoint point;
+        pathing::TextParser::Status status;
+        std::vector<pathing::Point> points;
+        std::vector<float> headings;
+        while ((status = parser.next(point)) != pathing::TextParser::Status::END) {
+            if (status != pathing::TextParser::Status::POINT) continue;
+            points.push_back({point.x, point.y, point.speed});
+            headings.push_back(point.heading);
+        }
+
+        std::vector<pathing::Point> resampled;
+        std::vector<float> resampledHeadings;
+        pathing::resample(points, headings, {}, resampled, resampledHeadings);
+
+        const std::vector<uint8_t> before = pathing::encode(points);
+        const std::vector<uint8_t> after = pathing::encode(resampled);
+        const pathing::PathView beforeView = pathing::PathView::fromAsset({const_cast<uint8_t*>(before.data()),
+                                                                           before.size()});
+        const pathing::PathView afterView = pathing::PathView::fromAsset({const_cast<uint8_t*>(after.data()),
+                                                                          after.size()});
+        const std::vector<Position> positions = drive(beforeView, false);
+
+        const std::string base = host::baseName(name);
+        originals.emplace(base.substr(0, base.size() - 4), points);
+        resamples.emplace(base.substr(0, base.size() - 4), resampled);
+
+        float distance;
+        float speed;
+        deviation(points, resampled, distance, speed);
+        pointsTotal += points.size();
+        resampledTotal += resampled.size();
+
+        std::printf("%-24s %7zu %7zu %7zu %7zu %9.3f %9.2f %9.0f %9.0f\n", host::baseName(name).c_str(), points.size(),
+                    resampled.size(), before.size(), after.size(), distance, speed, cursorNs(beforeView, positions),
+                    cursorNs(afterView, positions));
+    }
+
+    if (pointsTotal > 0) {
+        std::printf("\n%zu points -> %zu, %.1fx fewer\n", pointsTotal, resampledTotal,
+                    double(pointsTotal) / resampledTotal);
+    }
+
+    // the match routines follow with a fixed 10" lookahead, the rest with the default policy
+    const pathing::LookaheadPolicy policies[] = {pathing::LookaheadPolicy::fixed(10), pathing::LookaheadPolicy()};
+    bool header = false;
+    bool failed = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 5 || name.compare(name.size() - 5, 5, ".path") != 0) continue;
+        const std::string base = host::baseName(name);
+        const auto original = originals.find(base.substr(0, base.size() - 5));
+        if (original == originals.end() || original->second.size() < 2) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        const asset data = {file.data(), file.size()};
+        std::vector<uint8_t> decoded(pathing::decodedSize(data));
+        pathing::LoadResult loaded;
+        const pathing::PathView compiled = pathing::decode(data, decoded.data(), decoded.size(), &loaded);
+        if (loaded != pathing::LoadResult::OK) {
+            std::fprintf(stderr, "%s: %s\n", argv[i], pathing::toString(loaded));
+            return 1;
+        }
+        if (compiled.size() < 2) continue;
+
+        const std::vector<uint8_t> before = pathing::encode(original->second);
+        const std::vector<uint8_t> after = pathing::encode(resamples[original->first]);
+        const pathing::PathView beforeView = pathing::PathView::fromAsset({const_cast<uint8_t*>(before.data()),
+                                                                           before.size()});
+        const pathing::PathView afterView = pathing::PathView::fromAsset({const_cast<uint8_t*>(after.data()),
+                                                                          after.size()});
+        if (!header) {
+            std::printf("\n%-24s %7s %28s %28s\n", "follow error", "points", "fixed 10 orig/resamp/asset",
+                        "adaptive orig/resamp/asset");
+            header = true;
+        }
+        std::printf("%-24s %7zu", base.c_str(), compiled.size());
+        bool ok = true;
+        for (const pathing::LookaheadPolicy& policy : policies) {
+            const float originalError = followPath(beforeView, policy, beforeView).maxError;
+            const float resampledError = followPath(afterView, policy, beforeView).maxError;
+            const float compiledError = followPath(compiled, policy, beforeView).maxError;
+            ok = ok && compiledError <= originalError * FOLLOW_RATIO + FOLLOW_MARGIN;
+            std::printf("  %7.2f\" %7.2f\" %7.2f\"", originalError, resampledError, compiledError);
+        }
+        std::printf("%s\n", ok ? "" : "  FAIL: followed worse than the original points");
+        failed = failed || !ok;
+    }
+    return failed ? 1 : 0;
+}
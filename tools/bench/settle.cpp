@@ -0,0 +1,57 @@
+// Time to settle, and error once the robot has stopped, with LemLib's exit conditions against velocity aware settle
+// conditions
+//
+//   make bench
+//   bin/tools/bench_settle
+//
+// Runs LemLib's moveToPoint and turnToHeading loops from lemlib.hpp, with KS of each side's power lost to static
+// friction. Each motion ends when its exit condition is met, then the robot coasts to a stop and the error left is
+// measured. Arguments are ignored.
+
+#include <cstdio>
+#include "lemlib.hpp"
+
+using motion::SettleCondition;
+
+static constexpr float KS = 5; // power that doesn't move the wheels
+
+// the small and large error exit conditions of the controller settings, as lemlib::ExitCondition checks them
+static SettleCondition lemlibExit() {
+    return SettleCondition::error(1, 110) | SettleCondition::error(3, 510);
+}
+
+// the conditions in src/config.cpp
+static SettleCondition lateralSettle() {
+    return (SettleCondition::error(1) & SettleCondition::velocity(2, 30)) |
+           (SettleCondition::error(3) & SettleCondition::velocity(1, 50)) | lemlibExit();
+}
+
+static SettleCondition angularSettle() {
+    return (SettleCondition::error(1) & SettleCondition::velocity(10, 30)) |
+           (SettleCondition::error(3) & SettleCondition::velocity(5, 50)) | lemlibExit();
+}
+
+static uint32_t lemlibTotal = 0;
+static uint32_t settleTotal = 0;
+
+static void print(const char* name, const SimResult& lemlib, const SimResult& settle) {
+    std::printf("%-12s %10u %10.2f %10u %10.2f %8d\n", name, lemlib.time, lemlib.error, settle.time, settle.error,
+                int(lemlib.time) - int(settle.time));
+    lemlibTotal += lemlib.time;
+    settleTotal += settle.time;
+}
+
+int main() {
+    std::printf("%-12s %21s %21s %8s\n", "motion", "lemlib ms / error", "settle ms / error", "saved ms");
+    char name[32];
+    for (float distance : {6.0f, 12.0f, 24.0f, 48.0f, 72.0f}) {
+        std::snprintf(name, sizeof(name), "move %.0f\"", distance);
+        print(name, simMove(distance, lemlibExit(), KS), simMove(distance, lateralSettle(), KS));
+    }
+    for (float degrees : {15.0f, 45.0f, 90.0f, 135.0f, 180.0f}) {
+        std::snprintf(name, sizeof(name), "turn %.0f deg", degrees);
+        print(name, simTurn(degrees, lemlibExit(), KS), simTurn(degrees, angularSettle(), KS));
+    }
+    std::printf("%-12s %10u %21u %8d\n", "total", lemlibTotal, settleTotal, int(lemlibTotal) - int(settleTotal));
+    return 0;
+}
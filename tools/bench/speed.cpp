@@ -0,0 +1,118 @@
+// Completion time, peak sideways acceleration and cross track error of pure pursuit with and without the physical
+// speed limits of pathing::limitSpeeds()
+//
+//   make bench
+//   bin/tools/bench_speed bin/paths/*.path
+//
+// Runs the loop in Chassis::pursue() with an 8" lookahead on SimRobot from drive.hpp. Each path is followed at its
+// file speeds, capped by the limits, and with every speed in the file raised to 127 and capped by the limits. The
+// simulated wheels never slide, so sideways acceleration above what the carpet holds shows up as the peak instead.
+// Arguments that aren't .path files are ignored.
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "path/pursuit.hpp"
+#include "path/speed.hpp"
+#include "../host.hpp"
+#include "drive.hpp"
+
+static constexpr float DT = 0.01;
+static constexpr float TIMEOUT = 30;
+static constexpr float LOOKAHEAD = 8;
+// the limits suggested in src/config.cpp
+static constexpr pathing::SpeedLimits LIMITS = {150, 200};
+
+namespace {
+struct Result {
+        float time; /** seconds until the path ended, NAN if it didn't */
+        float lateral; /** highest sideways acceleration, inches per second squared */
+        float maxError; /** furthest from the path, inches */
+};
+} // namespace
+
+static Result simulate(const pathing::PathView& path, const float* speeds) {
+    const pathing::Point first = path[0];
+    const pathing::Point second = path[1];
+    SimRobot robot {first.x, first.y, std::atan2(second.x - first.x, second.y - first.y)};
+    pathing::PathCursor cursor(path);
+    Result result {NAN, 0, 0};
+    for (float t = 0; t < TIMEOUT; t += DT) {
+        const size_t closest = cursor.update(robot.x, robot.y);
+        const float speed = speeds[closest];
+        if (speed == 0) {
+            result.time = t;
+            break;
+        }
+        const pathing::Point target = cursor.lookahead(robot.x, robot.y, LOOKAHEAD);
+        const float curvature =
+            std::hypot(target.x - robot.x, target.y - robot.y) < 0.01 ? 0 : arcCurvature(robot, target.x, target.y);
+        float left = speed * (2 + curvature * SimRobot::TRACK) / 2;
+        float right = speed * (2 - curvature * SimRobot::TRACK) / 2;
+        const float ratio = std::fmax(std::fabs(left), std::fabs(right)) / 127;
+        if (ratio > 1) {
+            left /= ratio;
+            right /= ratio;
+        }
+        robot.step(left, right, DT);
+
+        // velocity times turn rate
+        const float lateral = (robot.left + robot.right) / 2 * (robot.left - robot.right) / SimRobot::TRACK;
+        result.lateral = std::fmax(result.lateral, std::fabs(lateral));
+        result.maxError = std::fmax(result.maxError, crossTrack(path, robot.x, robot.y));
+    }
+    return result;
+}
+
+static void print(const Result& result) {
+    char time[16] = "-";
+    if (!std::isnan(result.time)) std::snprintf(time, sizeof(time), "%.2f", result.time);
+    std::printf(" %6s %6.0f %6.2f\"", time, result.lateral, result.maxError);
+}
+
+int main(int argc, char** argv) {
+    std::printf("%-24s %22s %22s %22s\n", "path", "file s / lat / max", "limited s / lat / max",
+                "127 limited s / lat / max");
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 5 || name.compare(name.size() - 5, 5, ".path") != 0) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        const asset data = {file.data(), file.size()};
+        std::vector<uint8_t> decoded(pathing::decodedSize(data));
+        pathing::LoadResult loaded;
+        const pathing::PathView path = pathing::decode(data, decoded.data(), decoded.size(), &loaded);
+        if (loaded != pathing::LoadResult::OK) {
+            std::fprintf(stderr, "%s: %s\n", argv[i], pathing::toString(loaded));
+            return 1;
+        }
+        if (path.size() < 2) continue;
+
+        std::vector<float> speeds(path.size());
+        for (size_t k = 0; k < path.size(); k++) speeds[k] = path[k].speed;
+        std::vector<float> limited(path.size());
+        pathing::limitSpeeds(path, LIMITS, SimRobot::WHEEL_SPEED, limited.data());
+
+        // the same path drawn at full speed, the limits are all that slow it down
+        std::vector<pathing::Point> points;
+        for (size_t k = 0; k < path.size(); k++) {
+            points.push_back({path[k].x, path[k].y, path[k].speed == 0 ? 0 : 127.0f});
+        }
+        const std::vector<uint8_t> fastData = pathing::encode(points);
+        const pathing::PathView fast = pathing::PathView::fromAsset({const_cast<uint8_t*>(fastData.data()),
+                                                                     fastData.size()});
+        std::vector<float> fastLimited(fast.size());
+        pathing::limitSpeeds(fast, LIMITS, SimRobot::WHEEL_SPEED, fastLimited.data());
+
+        std::printf("%-24s", host::baseName(name).c_str());
+        print(simulate(path, speeds.data()));
+        print(simulate(path, limited.data()));
+        print(simulate(fast, fastLimited.data()));
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Expected duration of moves and turns from the kinematic model, against how long LemLib's loops take to settle on
+// the simulated robot, and the automatic timeout each would get
+//
+//   make bench
+//   bin/tools/bench_timeout
+//
+// The model uses the feedforward gains and track width in src/config.cpp and the default TimeoutParams. The robot is
+// simulated as in bench_settle, with the settle conditions in src/config.cpp and KS of each side's power lost to
+// static friction. A motion that takes longer than its timeout would have been cut short. Arguments are ignored.
+
+#include <algorithm>
+#include <cstdio>
+#include "motion/timeout.hpp"
+#include "lemlib.hpp"
+
+using motion::SettleCondition;
+
+static constexpr float KS = 5; // power that doesn't move the wheels
+
+static SettleCondition lateralSettle() {
+    return (SettleCondition::error(1) & SettleCondition::velocity(2, 30)) |
+           (SettleCondition::error(3) & SettleCondition::velocity(1, 50)) | SettleCondition::error(1, 110) |
+           SettleCondition::error(3, 510);
+}
+
+static SettleCondition angularSettle() {
+    return (SettleCondition::error(1) & SettleCondition::velocity(10, 30)) |
+           (SettleCondition::error(3) & SettleCondition::velocity(5, 50)) | SettleCondition::error(1, 110) |
+           SettleCondition::error(3, 510);
+}
+
+static const motion::TimeoutParams params;
+static int cutShort = 0;
+static int worstSlack = 0;
+
+static void print(const char* name, float seconds, uint32_t actual) {
+    const uint32_t expected = uint32_t(std::lround(seconds * 1000)) + params.settleTime;
+    const int timeout = params.resolve(motion::AUTO_TIMEOUT, expected);
+    std::printf("%-18s %10u %10u %10d %8.2f\n", name, expected, actual, timeout, float(actual) / expected);
+    if (int(actual) > timeout) cutShort++;
+    worstSlack = std::max(worstSlack, timeout - int(actual));
+}
+
+int main() {
+    const motion::DurationModel model({0, 1.66, 0.166}, SimRobot::TRACK);
+    std::printf("%-18s %10s %10s %10s %8s\n", "motion", "expected", "actual", "timeout", "ratio");
+    char name[32];
+    for (float power : {127.0f, 70.0f}) {
+        for (float distance : {6.0f, 12.0f, 24.0f, 48.0f, 72.0f}) {
+            std::snprintf(name, sizeof(name), "move %.0f\" at %.0f", distance, power);
+            print(name, model.move(distance, power), simMove(distance, lateralSettle(), KS, power).time);
+        }
+        for (float degrees : {15.0f, 45.0f, 90.0f, 135.0f, 180.0f}) {
+            std::snprintf(name, sizeof(name), "turn %.0f at %.0f", degrees, power);
+            print(name, model.turn(degrees, power), simTurn(degrees, angularSettle(), KS, power).time);
+        }
+    }
+    std::printf("cut short: %d, most time to spare: %d ms\n", cutShort, worstSlack);
+    return 0;
+}
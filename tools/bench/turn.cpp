@@ -0,0 +1,113 @@
+// Time to settle and error left by LemLib's PID turns and swings against profiled ones, on the same headings
+//
+//   make bench
+//   bin/tools/bench_turn
+//
+// Everything runs on the simulated robot in lemlib.hpp, with KS of each side's power lost to static friction, and ends
+// on the angular settle condition in src/config.cpp. The profiled turns and swings follow the 540 deg/s, 2700 deg/s^2
+// profile suggested in src/config.cpp the way Chassis::profiledTurn() does, with the feedforward gains in
+// src/config.cpp. Swings run with three amounts of friction to show how repeatable the end heading is, and lock the
+// right side, which is the weaker one on SimRobot. Arguments are ignored.
+
+#include <algorithm>
+#include <cstdio>
+#include "motion/feedforward.hpp"
+#include "path/profile.hpp"
+#include "lemlib.hpp"
+
+using motion::SettleCondition;
+
+static constexpr float KS = 5; // power that doesn't move the wheels
+static const pathing::ProfileLimits LIMITS = {540, 2700, 0};
+static const motion::Feedforward FEEDFORWARD = {0, 1.66, 0.166};
+
+static SettleCondition angularSettle() {
+    return (SettleCondition::error(1) & SettleCondition::velocity(10, 30)) |
+           (SettleCondition::error(3) & SettleCondition::velocity(5, 50)) | SettleCondition::error(1, 110) |
+           SettleCondition::error(3, 510);
+}
+
+// a swing locks the right side and follows half the angular limits, see Chassis::setAngularProfile()
+static SimResult profiledTurn(float degrees, bool swing, float ks) {
+    SimRobot robot {0, 0, 0};
+    SimPid angularPid {2, 10};
+    SettleCondition settle = angularSettle();
+    const float wheelPerDegree = M_PI / 180 * (swing ? SimRobot::TRACK : SimRobot::TRACK / 2);
+    const float scale = swing ? 0.5 : 1;
+    const pathing::MotionProfile profile(degrees, {LIMITS.maxVelocity * scale, LIMITS.maxAcceleration * scale});
+    uint32_t time = 0;
+    for (; time < SIM_TIMEOUT; time += 10) {
+        const float turned = robot.heading * 180 / M_PI;
+        const float rate = (robot.left - robot.right) / SimRobot::TRACK * 180 / M_PI;
+        const float elapsed = time / 1000.0f;
+        float feedforward = 0;
+        float angular;
+        if (elapsed < profile.duration()) {
+            const pathing::ProfileState state = profile.sample(elapsed);
+            feedforward = FEEDFORWARD.power(state.velocity * wheelPerDegree, state.acceleration * wheelPerDegree);
+            angular = angularPid.update(state.position - turned);
+        } else {
+            const float error = degrees - turned;
+            if (settle.update(error, rate, time)) break;
+            angular = angularPid.update(error);
+        }
+        angular = std::fmax(std::fmin(angular, 127.0f), -127.0f);
+        float left = feedforward + angular;
+        float right = -feedforward - angular;
+        const float ratio = std::fmax(std::fabs(left), std::fabs(right)) / 127;
+        if (ratio > 1) {
+            left /= ratio;
+            right /= ratio;
+        }
+        robot.step(simFriction(left, ks), swing ? 0 : simFriction(right, ks), SIM_DT);
+        if (swing) simHold(robot, true);
+    }
+    simCoast(robot);
+    return {time, float(std::fabs(degrees - robot.heading * 180 / M_PI))};
+}
+
+int main() {
+    std::printf("%-12s %21s %21s %8s\n", "turn", "pid ms / error", "profiled ms / error", "saved ms");
+    uint32_t pidTotal = 0;
+    uint32_t profiledTotal = 0;
+    for (float degrees : {15.0f, 30.0f, 45.0f, 90.0f, 135.0f, 180.0f}) {
+        const SimResult pid = simTurn(degrees, angularSettle(), KS);
+        const SimResult profiled = profiledTurn(degrees, false, KS);
+        std::printf("%-12.0f %10u %10.2f %10u %10.2f %8d\n", degrees, pid.time, pid.error, profiled.time,
+                    profiled.error, int(pid.time) - int(profiled.time));
+        pidTotal += pid.time;
+        profiledTotal += profiled.time;
+    }
+    std::printf("%-12s %10u %21u %8d\n\n", "total", pidTotal, profiledTotal, int(pidTotal) - int(profiledTotal));
+
+    // time is the average and error the range over the three amounts of friction
+    std::printf("%-12s %21s %21s %8s\n", "swing", "pid ms / error", "profiled ms / error", "saved ms");
+    pidTotal = 0;
+    profiledTotal = 0;
+    for (float degrees : {30.0f, 56.0f, 90.0f, 135.0f}) {
+        uint32_t pidTime = 0;
+        uint32_t profiledTime = 0;
+        float pidMin = INFINITY;
+        float pidMax = 0;
+        float profiledMin = INFINITY;
+        float profiledMax = 0;
+        for (float ks : {3.0f, 5.0f, 8.0f}) {
+            const SimResult pid = simSwing(degrees, true, angularSettle(), ks);
+            const SimResult profiled = profiledTurn(degrees, true, ks);
+            pidTime += pid.time;
+            profiledTime += profiled.time;
+            pidMin = std::min(pidMin, pid.error);
+            pidMax = std::max(pidMax, pid.error);
+            profiledMin = std::min(profiledMin, profiled.error);
+            profiledMax = std::max(profiledMax, profiled.error);
+        }
+        pidTime /= 3;
+        profiledTime /= 3;
+        std::printf("%-12.0f %10u %4.2f-%4.2f %10u %4.2f-%4.2f %8d\n", degrees, pidTime, pidMin, pidMax, profiledTime,
+                    profiledMin, profiledMax, int(pidTime) - int(profiledTime));
+        pidTotal += pidTime;
+        profiledTotal += profiledTime;
+    }
+    std::printf("%-12s %10u %21u %8d\n", "total", pidTotal, profiledTotal, int(pidTotal) - int(profiledTotal));
+    return 0;
+}
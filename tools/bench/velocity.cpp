@@ -0,0 +1,104 @@
+// How far the robot falls behind a trajectory when the battery sags, driving the motors with voltage or with a
+// cascaded velocity loop
+//
+//   make bench
+//   bin/tools/bench_velocity bin/paths/*.traj
+//
+// The drivetrain is SimRobot in drive.hpp, with every motor power scaled down by the battery level to model sag. The
+// robot follows each trajectory with RAMSETE from src/motion/ramsete.cpp, driving the motors the way
+// Chassis::driveSides() in src/motion/velocity.cpp does in VOLTAGE and LOOP mode. The lag is the RMS distance from
+// the robot to where the trajectory says it should be at that time. Below about 80% the robot can't reach the
+// trajectories' top speed at all. Arguments that aren't .traj files are ignored.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "motion/feedforward.hpp"
+#include "path/ramsete.hpp"
+#include "path/trajectory.hpp"
+#include "../host.hpp"
+#include "drive.hpp"
+
+static constexpr float DT = 0.01;
+static constexpr float TRACK = SimRobot::TRACK;
+static constexpr float BATTERY[] = {1, 0.9, 0.8, 0.7};
+static constexpr float LOOP_KP = 3;
+
+static const motion::Feedforward FEEDFORWARD {0, 127 / SimRobot::WHEEL_SPEED,
+                                              127 / SimRobot::WHEEL_SPEED * SimRobot::LAG};
+
+// RMS distance from the robot to the trajectory's sample at each time, in inches
+static float simulate(const pathing::TrajectoryView& trajectory, float battery, bool loop) {
+    const pathing::TrajectorySample first = trajectory.front();
+    SimRobot robot {first.x, first.y, float(first.heading * M_PI / 180)};
+    float lag = 0;
+    size_t ticks = 0;
+    for (float t = 0; t <= trajectory.duration(); t += DT) {
+        const size_t index = trajectory.indexAt(t);
+        const pathing::TrajectorySample target = trajectory[index];
+        lag += std::pow(std::hypot(target.x - robot.x, target.y - robot.y), 2);
+        ticks++;
+
+        const pathing::ChassisSpeeds speeds = pathing::ramsete(target, robot.x, robot.y, robot.heading, {});
+        const pathing::WheelSpeeds accelerations = pathing::wheelAccelerations(trajectory, index, TRACK);
+        const float leftVelocity = speeds.velocity + speeds.angular * TRACK / 2;
+        const float rightVelocity = speeds.velocity - speeds.angular * TRACK / 2;
+        float left = FEEDFORWARD.power(leftVelocity, accelerations.left);
+        float right = FEEDFORWARD.power(rightVelocity, accelerations.right);
+        if (loop) {
+            left += LOOP_KP * (leftVelocity - robot.left);
+            right += LOOP_KP * (rightVelocity - robot.right);
+        }
+        left = std::clamp(left, -127.0f, 127.0f);
+        right = std::clamp(right, -127.0f, 127.0f);
+        robot.step(left * battery, right * battery, DT);
+    }
+    return std::sqrt(lag / ticks);
+}
+
+int main(int argc, char** argv) {
+    std::printf("%-24s %8s", "trajectory", "top in/s");
+    for (float battery : BATTERY) std::printf("   %3d%% voltage / loop", int(std::lround(battery * 100)));
+    std::printf("\n");
+    std::vector<float> voltageLag(std::size(BATTERY), 0);
+    std::vector<float> loopLag(std::size(BATTERY), 0);
+    int count = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::string name = argv[i];
+        if (name.size() < 5 || name.compare(name.size() - 5, 5, ".traj") != 0) continue;
+        std::vector<uint8_t> file;
+        if (!host::readFile(name, file)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        pathing::LoadResult loaded;
+        const pathing::TrajectoryView trajectory =
+            pathing::TrajectoryView::fromAsset({file.data(), file.size()}, &loaded);
+        if (loaded != pathing::LoadResult::OK) {
+            std::fprintf(stderr, "%s: %s\n", argv[i], pathing::toString(loaded));
+            return 1;
+        }
+        float top = 0;
+        for (size_t k = 0; k < trajectory.size(); k++) top = std::fmax(top, trajectory[k].velocity);
+
+        std::printf("%-24s %8.1f", host::baseName(name).c_str(), top);
+        for (size_t k = 0; k < std::size(BATTERY); k++) {
+            const float voltage = simulate(trajectory, BATTERY[k], false);
+            const float loop = simulate(trajectory, BATTERY[k], true);
+            voltageLag[k] += voltage;
+            loopLag[k] += loop;
+            std::printf("     %7.2f\" %7.2f\"", voltage, loop);
+        }
+        std::printf("\n");
+        count++;
+    }
+    if (count == 0) return 0;
+    std::printf("%-24s %8s", "mean", "");
+    for (size_t k = 0; k < std::size(BATTERY); k++) {
+        std::printf("     %7.2f\" %7.2f\"", voltageLag[k] / count, loopLag[k] / count);
+    }
+    std::printf("\n");
+    return 0;
+}
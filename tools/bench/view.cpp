@@ -0,0 +1,215 @@
+// Checks PathView reversed(), concatenated(), offset(), transformed() and slice() against the same operations done on
+// copies of the points, alone and chained the way routines chain them
+//
+//   make bench
+//   bin/tools/bench_view
+//
+// Arguments are ignored. Exits 1 if any view reads differently from its copy.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "path/view.hpp"
+
+using pathing::FieldTransform;
+using pathing::PathView;
+
+// a point as a view reads it, with its heading
+struct Copy {
+        float x, y, speed, heading;
+};
+
+using Copies = std::vector<Copy>;
+
+// packed the way a path asset with headings stores its points
+static std::vector<uint8_t> pack(const Copies& points) {
+    std::vector<uint8_t> data(points.size() * 16);
+    for (size_t i = 0; i < points.size(); i++) std::memcpy(data.data() + i * 16, &points[i], 16);
+    return data;
+}
+
+static float normalized(float theta) {
+    if (std::isnan(theta)) return theta;
+    theta = std::fmod(theta, 360.0f);
+    return theta < 0 ? theta + 360 : theta;
+}
+
+// index of the first point after the start with speed 0, or size() if there is none
+static size_t firstStop(const Copies& points) {
+    for (size_t i = 1; i < points.size(); i++) {
+        if (points[i].speed == 0) return i;
+    }
+    return points.size();
+}
+
+static Copies reversed(const Copies& points) {
+    const size_t stop = firstStop(points);
+    const Copies kept(points.begin(), points.begin() + (stop < points.size() ? stop + 1 : stop));
+    Copies out(kept.rbegin(), kept.rend());
+    // the robot starts the reversed path at the speed it reached the end of the original
+    if (kept.size() > 1) out[0].speed = kept[kept.size() - 2].speed;
+    return out;
+}
+
+static Copies slice(const Copies& points, size_t begin, size_t end) {
+    end = std::min(end, points.size());
+    if (begin >= end) return {};
+    return Copies(points.begin() + begin, points.begin() + end);
+}
+
+static Copies concatenated(const Copies& points, const Copies& next) {
+    Copies out(points.begin(), points.begin() + firstStop(points));
+    out.insert(out.end(), next.begin(), next.end());
+    return out;
+}
+
+static Copies offset(const Copies& points, float dx, float dy, float degrees) {
+    if (points.empty()) return points;
+    const float ox = points[0].x;
+    const float oy = points[0].y;
+    const double radians = degrees * M_PI / 180;
+    Copies out = points;
+    for (Copy& point : out) {
+        const double x = point.x - ox;
+        const double y = point.y - oy;
+        point.x = float(x * std::cos(radians) + y * std::sin(radians) + ox + dx);
+        point.y = float(y * std::cos(radians) - x * std::sin(radians) + oy + dy);
+        point.heading = normalized(point.heading + degrees);
+    }
+    return out;
+}
+
+static Copies transformed(const Copies& points, FieldTransform transform) {
+    Copies out = points;
+    for (Copy& point : out) {
+        const bool flipX = transform == FieldTransform::FLIP_X || transform == FieldTransform::ROTATE_180;
+        const bool flipY = transform == FieldTransform::FLIP_Y || transform == FieldTransform::ROTATE_180;
+        if (flipX) point.x = -point.x;
+        if (flipY) point.y = -point.y;
+        // mirroring x turns clockwise into counterclockwise about +y, mirroring y measures from -y instead
+        if (flipX) point.heading = -point.heading;
+        if (flipY) point.heading = 180 - point.heading;
+        point.heading = normalized(point.heading);
+    }
+    return out;
+}
+
+static bool near(float a, float b, float tolerance) {
+    if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+    return std::fabs(a - b) <= tolerance;
+}
+
+static bool nearHeading(float a, float b) {
+    if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+    const float difference = std::fabs(a - b);
+    return std::min(difference, 360 - difference) <= 1e-2f;
+}
+
+static int failures = 0;
+
+static void check(const std::string& name, const PathView& view, Copies expected) {
+    // the last point of a view always reads with speed 0
+    if (!expected.empty()) expected.back().speed = 0;
+    std::string error;
+    if (view.size() != expected.size()) {
+        error = "size " + std::to_string(view.size()) + ", expected " + std::to_string(expected.size());
+    }
+    for (size_t i = 0; error.empty() && i < expected.size(); i++) {
+        const pathing::Point point = view[i];
+        const Copy& copy = expected[i];
+        char buffer[160];
+        std::snprintf(buffer, sizeof(buffer), "point %zu reads (%g, %g, %g, %g), expected (%g, %g, %g, %g)", i,
+                      point.x, point.y, point.speed, view.heading(i), copy.x, copy.y, copy.speed, copy.heading);
+        if (!near(point.x, copy.x, 1e-3f) || !near(point.y, copy.y, 1e-3f) || !near(point.speed, copy.speed, 1e-4f) ||
+            !nearHeading(view.heading(i), copy.heading)) {
+            error = buffer;
+        }
+    }
+    std::printf("%-64s %6zu  %s\n", name.c_str(), expected.size(), error.empty() ? "ok" : "FAIL");
+    if (!error.empty()) {
+        std::printf("    %s\n", error.c_str());
+        failures++;
+    }
+}
+
+int main() {
+    // an approach that stops to grab a goal and then carries on, so reversing and concatenating have to cut it
+    const Copies approach = {{-60, -36, 40, 90},   {-52, -35, 55, 85},  {-44, -32, 70, NAN}, {-36, -28, 70, 60},
+                             {-29, -22, 50, 45},   {-24, -14, 30, 30},  {-22, -6, 0, 15},    {-21, 2, 40, 5},
+                             {-21, 10, 60, 0}};
+    // a plain curve ending the way JerryIO exports do, with the last point repeated at speed 0
+    const Copies curve = {{-20, 12, 60, 350}, {-24, 20, 65, 330}, {-31, 26, 65, 300}, {-40, 28, 50, 270},
+                          {-48, 27, 30, 255}, {-48, 27, 0, 255}};
+    const Copies line = {{0, 0, 80, 0}, {0, 6, 80, 0}, {0, 12, 80, 0}, {0, 18, 80, 0}};
+
+    const std::vector<uint8_t> approachData = pack(approach);
+    const std::vector<uint8_t> curveData = pack(curve);
+    const std::vector<uint8_t> lineData = pack(line);
+    const PathView a(approachData.data(), approach.size(), 16);
+    const PathView b(curveData.data(), curve.size(), 16);
+    const PathView c(lineData.data(), line.size(), 16);
+
+    std::printf("%-64s %6s  %s\n", "view", "points", "result");
+    check("approach", a, approach);
+    check("approach.reversed()", a.reversed(), reversed(approach));
+    check("curve.reversed()", b.reversed(), reversed(curve));
+    check("approach.reversed().reversed()", a.reversed().reversed(), reversed(reversed(approach)));
+    check("approach.slice(2, 8)", a.slice(2, 8), slice(approach, 2, 8));
+    check("approach.slice(7, 20)", a.slice(7, 20), slice(approach, 7, 20));
+    check("curve.reversed().slice(1, 4)", b.reversed().slice(1, 4), slice(reversed(curve), 1, 4));
+    check("curve.slice(1, 5).reversed()", b.slice(1, 5).reversed(), reversed(slice(curve, 1, 5)));
+    check("approach.concatenated(curve)", a.concatenated(b), concatenated(approach, curve));
+    check("curve.concatenated(line)", b.concatenated(c), concatenated(curve, line));
+    check("approach.concatenated(curve).reversed()", a.concatenated(b).reversed(),
+          reversed(concatenated(approach, curve)));
+    check("line.concatenated(curve).reversed()", c.concatenated(b).reversed(), reversed(concatenated(line, curve)));
+    check("line.concatenated(curve.reversed())", c.concatenated(b.reversed()), concatenated(line, reversed(curve)));
+    check("line.concatenated(approach.reversed()).reversed()", c.concatenated(a.reversed()).reversed(),
+          reversed(concatenated(line, reversed(approach))));
+    check("curve.concatenated(line.slice(2, 3)).reversed()", b.concatenated(c.slice(2, 3)).reversed(),
+          reversed(concatenated(curve, slice(line, 2, 3))));
+    check("curve.offset(0, 24, 90)", b.offset(0, 24, 90), offset(curve, 0, 24, 90));
+    check("approach.offset(-3, 5, -37)", a.offset(-3, 5, -37), offset(approach, -3, 5, -37));
+    check("curve.offset(4, 0, 30).offset(0, -6, 45)", b.offset(4, 0, 30).offset(0, -6, 45),
+          offset(offset(curve, 4, 0, 30), 0, -6, 45));
+    check("line.concatenated(curve.offset(20, 12, 90))", c.concatenated(b.offset(20, 12, 90)),
+          concatenated(line, offset(curve, 20, 12, 90)));
+    check("line.concatenated(curve).offset(5, 5, 120)", c.concatenated(b).offset(5, 5, 120),
+          offset(concatenated(line, curve), 5, 5, 120));
+
+    const FieldTransform transforms[] = {FieldTransform::NONE, FieldTransform::FLIP_X, FieldTransform::FLIP_Y,
+                                         FieldTransform::ROTATE_180};
+    const char* transformNames[] = {"NONE", "FLIP_X", "FLIP_Y", "ROTATE_180"};
+    for (int t = 0; t < 4; t++) {
+        const FieldTransform transform = transforms[t];
+        const std::string name = transformNames[t];
+        check("approach.transformed(" + name + ")", a.transformed(transform), transformed(approach, transform));
+        check("curve.offset(2, 6, 35).transformed(" + name + ")", b.offset(2, 6, 35).transformed(transform),
+              transformed(offset(curve, 2, 6, 35), transform));
+        check("curve.transformed(" + name + ").offset(2, 6, 35)", b.transformed(transform).offset(2, 6, 35),
+              offset(transformed(curve, transform), 2, 6, 35));
+        check("approach.concatenated(curve).transformed(" + name + ").reversed()",
+              a.concatenated(b).transformed(transform).reversed(),
+              reversed(transformed(concatenated(approach, curve), transform)));
+        for (int u = 1; u < 4; u++) {
+            check("curve.transformed(" + name + ").transformed(" + transformNames[u] + ")",
+                  b.transformed(transform).transformed(transforms[u]),
+                  transformed(transformed(curve, transform), transforms[u]));
+        }
+    }
+
+    // more runs than a view holds gives an empty view
+    PathView route = c;
+    Copies routeCopy = line;
+    for (size_t i = 1; i < PathView::MAX_PIECES; i++) {
+        route = route.concatenated(c.offset(0, 18 * i));
+        routeCopy = concatenated(routeCopy, offset(line, 0, 18 * i, 0));
+    }
+    check("line concatenated to MAX_PIECES runs", route, routeCopy);
+    check("one run past MAX_PIECES", route.concatenated(c), {});
+
+    std::printf("\n%d failed\n", failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+// Helpers shared by the host side tools and benchmarks. Never included by robot code.
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace host {
+
+inline bool readFile(const std::string& name, std::vector<uint8_t>& out) {
+    std::ifstream in(name, std::ios::binary);
+    if (!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+inline std::string baseName(const std::string& name) {
+    const size_t slash = name.find_last_of("/\\");
+    return slash == std::string::npos ? name : name.substr(slash + 1);
+}
+
+/**
+ * @brief keep a result alive so the benchmarked code isn't optimized away
+ */
+inline void keep(size_t value) {
+    // an empty asm that claims to read the value, without storing it anywhere
+    asm volatile("" : : "r"(value) : "memory");
+}
+
+/**
+ * @brief run fn repeatedly for at least minSeconds and return the average time per call in nanoseconds
+ */
+template <typename F> double timeNs(F&& fn, double minSeconds = 0.05) {
+    using clock = std::chrono::steady_clock;
+    size_t calls = 0;
+    const clock::time_point start = clock::now();
+    clock::duration elapsed;
+    do {
+        fn();
+        calls++;
+        elapsed = clock::now() - start;
+    } while (elapsed < std::chrono::duration<double>(minSeconds));
+    return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+} // namespace host
@@ -0,0 +1,169 @@
+#pragma once
+
+// Minimal JSON reader for the host tools, enough to read the trailer path.jerryio appends to path files.
+// Never included by robot code.
+
+#include <cctype>
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+struct Value {
+        enum class Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+        Type type = Type::NUL;
+        bool boolean = false;
+        double number = 0;
+        std::string string;
+        std::vector<Value> array;
+        std::vector<std::pair<std::string, Value>> object;
+
+        /**
+         * @brief get a member of an object, or nullptr if this isn't an object or has no such member
+         */
+        const Value* get(const std::string& key) const {
+            if (type != Type::OBJECT) return nullptr;
+            for (const auto& member : object) {
+                if (member.first == key) return &member.second;
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief follow a chain of object members, or nullptr if any of them is missing
+         */
+        const Value* path(std::initializer_list<const char*> keys) const {
+            const Value* value = this;
+            for (const char* key : keys) {
+                if (value == nullptr) return nullptr;
+                value = value->get(key);
+            }
+            return value;
+        }
+
+        /**
+         * @brief get a member as a number, or fallback if it is missing or not a number
+         */
+        double numberOr(std::initializer_list<const char*> keys, double fallback) const {
+            const Value* value = path(keys);
+            return value != nullptr && value->type == Type::NUMBER ? value->number : fallback;
+        }
+};
+
+class Reader {
+    public:
+        Reader(const char* begin, const char* end)
+            : cursor(begin),
+              end(end) {}
+
+        /**
+         * @brief read one value. Returns false if the text is not valid JSON
+         */
+        bool read(Value& out) {
+            skipSpace();
+            if (cursor == end) return false;
+            switch (*cursor) {
+                case '{': return readObject(out);
+                case '[': return readArray(out);
+                case '"': out.type = Value::Type::STRING; return readString(out.string);
+                case 't': out.type = Value::Type::BOOL; out.boolean = true; return literal("true");
+                case 'f': out.type = Value::Type::BOOL; out.boolean = false; return literal("false");
+                case 'n': out.type = Value::Type::NUL; return literal("null");
+                default: return readNumber(out);
+            }
+        }
+    private:
+        void skipSpace() {
+            while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r')) cursor++;
+        }
+
+        bool consume(char c) {
+            skipSpace();
+            if (cursor == end || *cursor != c) return false;
+            cursor++;
+            return true;
+        }
+
+        bool literal(const std::string& word) {
+            if (size_t(end - cursor) < word.size() || word.compare(0, word.size(), cursor, word.size()) != 0) {
+                return false;
+            }
+            cursor += word.size();
+            return true;
+        }
+
+        bool readNumber(Value& out) {
+            // strtod needs a terminated string, numbers are short so copy it out
+            const char* start = cursor;
+            while (cursor < end && (std::isdigit(static_cast<unsigned char>(*cursor)) || *cursor == '-' ||
+                                    *cursor == '+' || *cursor == '.' || *cursor == 'e' || *cursor == 'E')) {
+                cursor++;
+            }
+            const std::string text(start, cursor);
+            char* parsed;
+            out.type = Value::Type::NUMBER;
+            out.number = std::strtod(text.c_str(), &parsed);
+            return !text.empty() && *parsed == '\0';
+        }
+
+        bool readString(std::string& out) {
+            if (!consume('"')) return false;
+            out.clear();
+            while (cursor < end && *cursor != '"') {
+                if (*cursor == '\\') {
+                    if (++cursor == end) return false;
+                    switch (*cursor) {
+                        case 'n': out += '\n'; break;
+                        case 't': out += '\t'; break;
+                        case 'r': out += '\r'; break;
+                        case 'b': out += '\b'; break;
+                        case 'f': out += '\f'; break;
+                        case 'u':
+                            // names and uids only, so code points aren't decoded
+                            if (end - cursor < 5) return false;
+                            cursor += 4;
+                            out += '?';
+                            break;
+                        default: out += *cursor; break;
+                    }
+                    cursor++;
+                } else {
+                    out += *cursor++;
+                }
+            }
+            return consume('"');
+        }
+
+        bool readArray(Value& out) {
+            out.type = Value::Type::ARRAY;
+            consume('[');
+            if (consume(']')) return true;
+            do {
+                out.array.emplace_back();
+                if (!read(out.array.back())) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+
+        bool readObject(Value& out) {
+            out.type = Value::Type::OBJECT;
+            consume('{');
+            if (consume('}')) return true;
+            do {
+                std::string key;
+                skipSpace();
+                if (!readString(key) || !consume(':')) return false;
+                out.object.emplace_back(std::move(key), Value());
+                if (!read(out.object.back().second)) return false;
+            } while (consume(','));
+            return consume('}');
+        }
+
+        const char* cursor;
+        const char* end;
+};
+} // namespace json
@@ -0,0 +1,96 @@
+// pathc - host side path asset compiler
+//
+// Converts a path.jerryio text export (LemLib v0.5 or path.jerryio v0.1, see include/path/parser.hpp) into the
+// packed binary format described in include/path/format.hpp. Run automatically by firmware/path-asset.mk, but can
+// also be run by hand:
+//
+//   pathc static/RedRing1.txt bin/paths/RedRing1.path
+//
+// Points are kept as exported unless --tolerance is above 0, which resamples them by curvature (see
+// include/path/resample.hpp) with --speed-tolerance and --max-spacing.
+// Points are stored compressed (see FLAG_COMPRESSED) unless --raw is given.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "path/format.hpp"
+#include "path/parser.hpp"
+#include "path/resample.hpp"
+#include "host.hpp"
+
+static bool readPoints(const char* name, const std::vector<uint8_t>& text, std::vector<pathing::Point>& points,
+                       std::vector<float>& headings) {
+    const char* begin = reinterpret_cast<const char*>(text.data());
+    pathing::TextParser parser(begin, begin + text.size());
+    pathing::TextPoint point;
+    pathing::TextParser::Status status;
+    bool anyHeading = false;
+    while ((status = parser.next(point)) != pathing::TextParser::Status::END) {
+        if (status == pathing::TextParser::Status::MALFORMED) {
+            std::fprintf(stderr, "pathc: %s:%zu: warning: skipping malformed line\n", name, parser.line());
+            continue;
+        }
+        points.push_back({point.x, point.y, point.speed});
+        headings.push_back(point.heading);
+        if (!std::isnan(point.heading)) anyHeading = true;
+    }
+    // only keep the heading column if the path has one
+    if (!anyHeading) headings.clear();
+    return !points.empty();
+}
+
+int main(int argc, char** argv) {
+    pathing::ResampleSettings settings;
+    settings.tolerance = 0;
+    bool compress = true;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--raw") == 0) {
+            compress = false;
+            continue;
+        }
+        float* option = nullptr;
+        if (std::strcmp(argv[i], "--tolerance") == 0) option = &settings.tolerance;
+        else if (std::strcmp(argv[i], "--speed-tolerance") == 0) option = &settings.speedTolerance;
+        else if (std::strcmp(argv[i], "--max-spacing") == 0) option = &settings.maxSpacing;
+        if (option == nullptr) {
+            files.push_back(argv[i]);
+        } else if (i + 1 < argc) {
+            *option = std::strtof(argv[++i], nullptr);
+        }
+    }
+    if (files.size() != 2) {
+        std::fprintf(stderr, "usage: pathc [--tolerance in] [--speed-tolerance s] [--max-spacing in] [--raw] "
+                             "<input.txt> <output.path>\n");
+        return 2;
+    }
+
+    std::vector<uint8_t> text;
+    if (!host::readFile(files[0], text)) {
+        std::fprintf(stderr, "pathc: cannot open %s\n", files[0]);
+        return 1;
+    }
+
+    std::vector<pathing::Point> original;
+    std::vector<float> originalHeadings;
+    if (!readPoints(files[0], text, original, originalHeadings)) {
+        std::fprintf(stderr, "pathc: no points found in %s\n", files[0]);
+        return 1;
+    }
+
+    std::vector<pathing::Point> points;
+    std::vector<float> headings;
+    pathing::resample(original, originalHeadings, settings, points, headings);
+
+    const std::vector<uint8_t> out = pathing::encode(points, headings, compress);
+    std::ofstream file(files[1], std::ios::binary);
+    file.write(reinterpret_cast<const char*>(out.data()), out.size());
+    if (!file) {
+        std::fprintf(stderr, "pathc: cannot write %s\n", files[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// sysid - host side fit of drivetrain characterization logs
+//
+// Reads the sysid lines Chassis::characterize() prints (see include/motion/sysid.hpp) out of saved terminal output,
+// fits kS, kV and kA for each side and prints them in motor power units, ready for src/config.cpp:
+//
+//   pros terminal | tee sysid.log      run the CHARACTERIZE autonomous, then
+//   sysid sysid.log
+//
+// --synthetic fits logs of a simulated drivetrain with known gains instead, and fails if the gains don't come back.
+// `make sysid` runs it, so the fit can be checked without a robot:
+//
+//   sysid --synthetic [--noise 0.3]
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "motion/sysid.hpp"
+#include "host.hpp"
+
+static constexpr motion::SysIdTest TESTS[] = {
+    motion::SysIdTest::QUASISTATIC_FORWARD, motion::SysIdTest::QUASISTATIC_BACKWARD,
+    motion::SysIdTest::DYNAMIC_FORWARD, motion::SysIdTest::DYNAMIC_BACKWARD};
+
+// the samples in every sysid line of a log, other output is skipped
+static bool readLog(const char* name, std::vector<motion::SysIdSample>& samples) {
+    std::vector<uint8_t> text;
+    if (!host::readFile(name, text)) return false;
+    std::string line;
+    for (size_t i = 0; i <= text.size(); i++) {
+        if (i < text.size() && text[i] != '\n') {
+            line += char(text[i]);
+            continue;
+        }
+        motion::SysIdSample sample;
+        const size_t start = line.find("sysid,");
+        if (start != std::string::npos &&
+            std::sscanf(line.c_str() + start, "sysid,%f,%f,%f,%f", &sample.time, &sample.voltage,
+                        &sample.leftVelocity, &sample.rightVelocity) == 4) {
+            samples.push_back(sample);
+        }
+        line.clear();
+    }
+    return true;
+}
+
+namespace {
+// one side of a simulated drivetrain, gains in motor power units
+struct Side {
+        motion::Feedforward gains;
+        float velocity = 0;
+
+        void step(float power, float dt) {
+            // static friction holds the wheels until the power overcomes it
+            if (velocity == 0 && std::fabs(power) <= gains.kS) return;
+            const float direction = velocity != 0 ? velocity : power;
+            const float friction = gains.kS * (direction > 0 ? 1 : -1);
+            const float next = velocity + (power - friction - gains.kV * velocity) / gains.kA * dt;
+            // friction can stop the wheels but not push them backwards
+            velocity = velocity != 0 && (next > 0) != (velocity > 0) ? 0 : next;
+        }
+};
+} // namespace
+
+// run every test on a simulated drivetrain, sampling like the robot does with noisy, quantized velocity readings
+static std::vector<motion::SysIdSample> simulate(const motion::Feedforward& left, const motion::Feedforward& right,
+                                                 float noise) {
+    // the motors report whole rpm, 600 rpm cartridges geared to 450 rpm 3.25" wheels
+    const float resolution = 450.0f / 600 * M_PI * 3.25f / 60;
+    std::mt19937 random(1);
+    std::normal_distribution<float> jitter(0, noise);
+    auto read = [&](float velocity) { return std::round((velocity + jitter(random)) / resolution) * resolution; };
+
+    const motion::SysIdParams params;
+    std::vector<motion::SysIdSample> samples;
+    for (motion::SysIdTest test : TESTS) {
+        Side sides[2] = {{left}, {right}};
+        const float duration = motion::sysIdDuration(test, params);
+        for (int tick = 0; tick * 0.01f < duration; tick++) {
+            const float time = tick * 0.01f;
+            const float voltage = motion::sysIdVoltage(test, time, params);
+            samples.push_back({time, voltage, read(sides[0].velocity), read(sides[1].velocity)});
+            for (int i = 0; i < 10; i++) {
+                for (Side& side : sides) side.step(voltage / 12 * 127, 0.001);
+            }
+        }
+    }
+    return samples;
+}
+
+static void print(const char* name, const motion::Feedforward& gains, float r2) {
+    std::printf("%-6s kS %6.2f  kV %6.3f  kA %6.3f  r^2 %.4f\n", name, gains.kS, gains.kV, gains.kA, r2);
+}
+
+static bool close(float fitted, float actual, float tolerance) {
+    return std::fabs(fitted - actual) <= tolerance * std::fabs(actual);
+}
+
+int main(int argc, char** argv) {
+    bool synthetic = false;
+    float noise = 0.3;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--synthetic") == 0) synthetic = true;
+        else if (std::strcmp(argv[i], "--noise") == 0 && i + 1 < argc) noise = std::strtof(argv[++i], nullptr);
+        else files.push_back(argv[i]);
+    }
+    if (synthetic == !files.empty()) {
+        std::fprintf(stderr, "usage: sysid <terminal log>... | sysid --synthetic [--noise in/s]\n");
+        return 2;
+    }
+
+    // roughly the drivetrain in src/config.cpp, with the sides a little different
+    const motion::Feedforward left {6, 1.6, 0.22};
+    const motion::Feedforward right {7, 1.65, 0.25};
+    std::vector<motion::SysIdSample> samples;
+    if (synthetic) {
+        samples = simulate(left, right, noise);
+    } else {
+        for (const char* file : files) {
+            if (!readLog(file, samples)) {
+                std::fprintf(stderr, "sysid: cannot open %s\n", file);
+                return 1;
+            }
+        }
+    }
+
+    const motion::SysIdFit fit = motion::fitFeedforward(samples);
+    if (fit.left.kV <= 0 || fit.right.kV <= 0) {
+        std::fprintf(stderr, "sysid: %zu samples were not enough to fit, did the robot move?\n", samples.size());
+        return 1;
+    }
+    std::printf("%zu samples, %zu fitted\n", samples.size(), fit.samples);
+    print("left", fit.left, fit.leftR2);
+    print("right", fit.right, fit.rightR2);
+    std::printf("max velocity %.1f in/s, max acceleration %.0f in/s^2\n", fit.maxVelocity, fit.maxAcceleration);
+    if (!synthetic) return 0;
+
+    print("actual", left, 1);
+    print("actual", right, 1);
+    // kA comes from the short dynamic tests and is the hardest to pin down
+    const bool ok = close(fit.left.kS, left.kS, 0.1) && close(fit.left.kV, left.kV, 0.05) &&
+                    close(fit.left.kA, left.kA, 0.15) && close(fit.right.kS, right.kS, 0.1) &&
+                    close(fit.right.kV, right.kV, 0.05) && close(fit.right.kA, right.kA, 0.15);
+    std::printf("%s\n", ok ? "fit matches the simulated drivetrain" : "fit does NOT match the simulated drivetrain");
+    return ok ? 0 : 1;
+}
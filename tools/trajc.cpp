@@ -0,0 +1,127 @@
+// trajc - host side trajectory generator
+//
+// Reads the Bezier control points, speed limit and deceleration rate from the #PATH.JERRYIO-DATA trailer of a
+// path.jerryio export and writes a time parameterized trajectory (see include/path/trajectory.hpp). Run automatically
+// by firmware/trajectory-asset.mk, but can also be run by hand:
+//
+//   trajc --rpm 450 --wheel 3.25 --track 11.4 --accel 100 --dt 0.01 static/RedRing1.txt bin/paths/RedRing1.traj
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "path/trajectory.hpp"
+#include "host.hpp"
+#include "json.hpp"
+
+static constexpr char TRAILER[] = "#PATH.JERRYIO-DATA";
+
+// read the segments of the first path in the trailer
+static bool readSegments(const json::Value& data, std::vector<pathing::Cubic>& segments) {
+    const json::Value* paths = data.get("paths");
+    if (paths == nullptr || paths->type != json::Value::Type::ARRAY || paths->array.empty()) return false;
+    const json::Value* list = paths->array[0].get("segments");
+    if (list == nullptr || list->type != json::Value::Type::ARRAY) return false;
+
+    // the unit of length in centimeters, LemLib paths are in inches
+    const double scale = data.numberOr({"gc", "uol"}, 2.54) / 2.54;
+
+    for (const json::Value& segment : list->array) {
+        const json::Value* controls = segment.get("controls");
+        if (controls == nullptr || controls->type != json::Value::Type::ARRAY) return false;
+        std::vector<pathing::Vec2> points;
+        for (const json::Value& control : controls->array) {
+            const float x = control.numberOr({"x"}, NAN) * scale;
+            const float y = control.numberOr({"y"}, NAN) * scale;
+            if (std::isnan(x) || std::isnan(y)) return false;
+            points.push_back({x, y});
+        }
+        if (points.size() == 4) {
+            segments.push_back({points[0], points[1], points[2], points[3]});
+        } else if (points.size() == 2) {
+            // a straight segment is a cubic with its controls on the line
+            const pathing::Vec2 a = points[0];
+            const pathing::Vec2 b = points[1];
+            segments.push_back({a, pathing::Vec2 {a.x + (b.x - a.x) / 3, a.y + (b.y - a.y) / 3},
+                                pathing::Vec2 {a.x + (b.x - a.x) * 2 / 3, a.y + (b.y - a.y) * 2 / 3}, b});
+        } else {
+            return false;
+        }
+    }
+    return !segments.empty();
+}
+
+int main(int argc, char** argv) {
+    float rpm = 450;
+    float wheel = 3.25;
+    float track = 11.4;
+    float accel = 100;
+    float dt = 0.01;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        float* option = nullptr;
+        if (std::strcmp(argv[i], "--rpm") == 0) option = &rpm;
+        else if (std::strcmp(argv[i], "--wheel") == 0) option = &wheel;
+        else if (std::strcmp(argv[i], "--track") == 0) option = &track;
+        else if (std::strcmp(argv[i], "--accel") == 0) option = &accel;
+        else if (std::strcmp(argv[i], "--dt") == 0) option = &dt;
+        if (option == nullptr) {
+            files.push_back(argv[i]);
+        } else if (i + 1 < argc) {
+            *option = std::strtof(argv[++i], nullptr);
+        }
+    }
+    if (files.size() != 2) {
+        std::fprintf(stderr, "usage: trajc [--rpm r] [--wheel d] [--track w] [--accel a] [--dt s] <input.txt> "
+                             "<output.traj>\n");
+        return 2;
+    }
+
+    std::vector<uint8_t> text;
+    if (!host::readFile(files[0], text)) {
+        std::fprintf(stderr, "trajc: cannot open %s\n", files[0]);
+        return 1;
+    }
+    const char* begin = reinterpret_cast<const char*>(text.data());
+    const char* end = begin + text.size();
+    const char* trailer = std::search(begin, end, TRAILER, TRAILER + sizeof(TRAILER) - 1);
+    json::Value data;
+    if (trailer == end || !json::Reader(trailer + sizeof(TRAILER) - 1, end).read(data)) {
+        std::fprintf(stderr, "trajc: %s has no readable %s trailer\n", files[0], TRAILER);
+        return 1;
+    }
+
+    std::vector<pathing::Cubic> segments;
+    if (!readSegments(data, segments)) {
+        std::fprintf(stderr, "trajc: %s has no usable path segments\n", files[0]);
+        return 1;
+    }
+
+    pathing::TrajectoryLimits limits;
+    limits.maxVelocity = rpm * M_PI * wheel / 60;
+    limits.maxAcceleration = accel;
+    limits.trackWidth = track;
+    // speeds in the trailer are motor power out of 127, the same way follow() reads the speed column
+    const json::Value& path = data.get("paths")->array[0];
+    limits.speedLimit = path.numberOr({"pc", "speedLimit", "to"}, 127) / 127;
+    limits.decelerationRate = path.numberOr({"pc", "maxDecelerationRate"}, INFINITY) * limits.maxVelocity / 127;
+
+    const std::vector<pathing::TrajectorySample> samples = pathing::generateTrajectory(segments, limits, dt);
+    if (samples.empty()) {
+        std::fprintf(stderr, "trajc: could not generate a trajectory for %s\n", files[0]);
+        return 1;
+    }
+
+    const std::vector<uint8_t> out = pathing::encodeTrajectory(samples, dt);
+    std::ofstream file(files[1], std::ios::binary);
+    file.write(reinterpret_cast<const char*>(out.data()), out.size());
+    if (!file) {
+        std::fprintf(stderr, "trajc: cannot write %s\n", files[1]);
+        return 1;
+    }
+    return 0;
+}